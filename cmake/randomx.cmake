@@ -9,6 +9,8 @@ if (WITH_RANDOMX)
         src/crypto/rx/RxCache.h
         src/crypto/rx/RxConfig.h
         src/crypto/rx/RxDataset.h
+        src/crypto/rx/RxDatasetStore.h
+        src/crypto/rx/RxInitPool.h
         src/crypto/rx/RxQueue.h
         src/crypto/rx/RxSeed.h
         src/crypto/rx/RxVm.h
@@ -38,6 +40,8 @@ if (WITH_RANDOMX)
         src/crypto/rx/RxCache.cpp
         src/crypto/rx/RxConfig.cpp
         src/crypto/rx/RxDataset.cpp
+        src/crypto/rx/RxDatasetStore.cpp
+        src/crypto/rx/RxInitPool.cpp
         src/crypto/rx/RxQueue.cpp
         src/crypto/rx/RxVm.cpp
     )
@@ -92,6 +96,12 @@ if (WITH_RANDOMX)
         set_source_files_properties(src/crypto/randomx/jit_compiler_x86.cpp PROPERTIES COMPILE_FLAGS -Wno-unused-const-variable)
     endif()
 
+    if (WIN32)
+        list(APPEND SOURCES_CRYPTO src/crypto/rx/RxDatasetStore_win.cpp)
+    else()
+        list(APPEND SOURCES_CRYPTO src/crypto/rx/RxDatasetStore_unix.cpp)
+    endif()
+
     if (WITH_HWLOC)
         list(APPEND HEADERS_CRYPTO
              src/crypto/rx/RxNUMAStorage.h
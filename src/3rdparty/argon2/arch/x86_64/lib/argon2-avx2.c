@@ -324,12 +324,18 @@ void xmrig_ar2_fill_segment_avx2(const argon2_instance_t *instance, argon2_posit
 }
 
 
+#define ARGON2_LOCKSTEP_NAME xmrig_ar2_fill_segments_avx2
+#define ARGON2_LOCKSTEP_VEC  __m256i
+#define ARGON2_LOCKSTEP_VECS ARGON2_HWORDS_IN_BLOCK
+#include "argon2-template-lockstep.h"
+
 extern int cpu_flags_has_avx2(void);
 int xmrig_ar2_check_avx2(void) { return cpu_flags_has_avx2(); }
 
 #else
 
 void xmrig_ar2_fill_segment_avx2(const argon2_instance_t *instance, argon2_position_t position) {}
+void xmrig_ar2_fill_segments_avx2(const argon2_instance_t *const *instances, uint32_t count, argon2_position_t position) {}
 int xmrig_ar2_check_avx2(void) { return 0; }
 
 #endif
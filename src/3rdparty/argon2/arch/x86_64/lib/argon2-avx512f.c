@@ -308,12 +308,18 @@ void xmrig_ar2_fill_segment_avx512f(const argon2_instance_t *instance, argon2_po
     }
 }
 
+#define ARGON2_LOCKSTEP_NAME xmrig_ar2_fill_segments_avx512f
+#define ARGON2_LOCKSTEP_VEC  __m512i
+#define ARGON2_LOCKSTEP_VECS ARGON2_VECS_IN_BLOCK
+#include "argon2-template-lockstep.h"
+
 extern int cpu_flags_has_avx512f(void);
 int xmrig_ar2_check_avx512f(void) { return cpu_flags_has_avx512f(); }
 
 #else
 
 void xmrig_ar2_fill_segment_avx512f(const argon2_instance_t *instance, argon2_position_t position) {}
+void xmrig_ar2_fill_segments_avx512f(const argon2_instance_t *const *instances, uint32_t count, argon2_position_t position) {}
 int xmrig_ar2_check_avx512f(void) { return 0; }
 
 #endif
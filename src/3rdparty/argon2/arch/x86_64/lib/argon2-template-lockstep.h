@@ -0,0 +1,124 @@
+/*
+ * Lockstep segment filler shared by the AVX2 and AVX-512F implementations.
+ *
+ * The including file provides fill_block() and next_addresses() for its
+ * vector width and defines:
+ *   ARGON2_LOCKSTEP_NAME  name of the generated function,
+ *   ARGON2_LOCKSTEP_VEC   vector type of the compression state,
+ *   ARGON2_LOCKSTEP_VECS  number of vectors in one block.
+ */
+
+#include <string.h>
+
+#ifdef __GNUC__
+#   include <x86intrin.h>
+#else
+#   include <intrin.h>
+#endif
+
+#include "core.h"
+
+void ARGON2_LOCKSTEP_NAME(const argon2_instance_t *const *instances, uint32_t count, argon2_position_t position)
+{
+    const argon2_instance_t *instance = instances[0];
+    const block *ref_blocks[ARGON2_MAX_INTERLEAVE];
+    block address_block, input_block;
+    uint64_t pseudo_rand, ref_index, ref_lane;
+    uint32_t prev_offset, curr_offset;
+    uint32_t starting_index, i, k, line;
+    ARGON2_LOCKSTEP_VEC state[ARGON2_MAX_INTERLEAVE][ARGON2_LOCKSTEP_VECS];
+    int data_independent_addressing, with_xor;
+
+    if (count == 0 || count > ARGON2_MAX_INTERLEAVE) {
+        return;
+    }
+
+    /* All instances share the geometry, type and version, so the addressing
+     * state (and the address block for data-independent passes) is common,
+     * only the reference blocks differ. */
+    data_independent_addressing = (instance->type == Argon2_i) ||
+            (instance->type == Argon2_id && (position.pass == 0) &&
+             (position.slice < ARGON2_SYNC_POINTS / 2));
+
+    if (data_independent_addressing) {
+        init_block_value(&input_block, 0);
+
+        input_block.v[0] = position.pass;
+        input_block.v[1] = position.lane;
+        input_block.v[2] = position.slice;
+        input_block.v[3] = instance->memory_blocks;
+        input_block.v[4] = instance->passes;
+        input_block.v[5] = instance->type;
+    }
+
+    starting_index = 0;
+
+    if ((0 == position.pass) && (0 == position.slice)) {
+        starting_index = 2; /* we have already generated the first two blocks */
+
+        /* Don't forget to generate the first block of addresses: */
+        if (data_independent_addressing) {
+            next_addresses(&address_block, &input_block);
+        }
+    }
+
+    curr_offset = position.lane * instance->lane_length +
+                  position.slice * instance->segment_length + starting_index;
+
+    if (0 == curr_offset % instance->lane_length) {
+        prev_offset = curr_offset + instance->lane_length - 1;
+    } else {
+        prev_offset = curr_offset - 1;
+    }
+
+    for (k = 0; k < count; ++k) {
+        memcpy(state[k], ((instances[k]->memory + prev_offset)->v), ARGON2_BLOCK_SIZE);
+    }
+
+    with_xor = !(0 == position.pass || ARGON2_VERSION_10 == instance->version);
+
+    for (i = starting_index; i < instance->segment_length;
+         ++i, ++curr_offset, ++prev_offset) {
+        if (curr_offset % instance->lane_length == 1) {
+            prev_offset = curr_offset - 1;
+        }
+
+        if (data_independent_addressing && (i % ARGON2_ADDRESSES_IN_BLOCK == 0)) {
+            next_addresses(&address_block, &input_block);
+        }
+
+        position.index = i;
+
+        /* Resolve and prefetch the reference block of every instance first,
+         * the loads of the later ones overlap with the compression of the
+         * earlier ones. */
+        for (k = 0; k < count; ++k) {
+            if (data_independent_addressing) {
+                pseudo_rand = address_block.v[i % ARGON2_ADDRESSES_IN_BLOCK];
+            } else {
+                pseudo_rand = instances[k]->memory[prev_offset].v[0];
+            }
+
+            ref_lane = ((pseudo_rand >> 32)) % instance->lanes;
+
+            if ((position.pass == 0) && (position.slice == 0)) {
+                ref_lane = position.lane;
+            }
+
+            ref_index = xmrig_ar2_index_alpha(instance, &position, pseudo_rand & 0xFFFFFFFF, ref_lane == position.lane);
+            ref_blocks[k] = instances[k]->memory + instance->lane_length * ref_lane + ref_index;
+
+            for (line = 0; line < ARGON2_BLOCK_SIZE; line += 64) {
+                _mm_prefetch((const char *)ref_blocks[k] + line, _MM_HINT_T0);
+            }
+        }
+
+        for (k = 0; k < count; ++k) {
+            fill_block(state[k], ref_blocks[k], instances[k]->memory + curr_offset, with_xor);
+        }
+    }
+}
+
+#undef ARGON2_LOCKSTEP_NAME
+#undef ARGON2_LOCKSTEP_VEC
+#undef ARGON2_LOCKSTEP_VECS
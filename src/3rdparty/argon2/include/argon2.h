@@ -40,6 +40,9 @@ extern "C" {
 /* Number of synchronization points between lanes per pass */
 #define ARGON2_SYNC_POINTS UINT32_C(4)
 
+/* Maximum number of independent hashes computed in lockstep */
+#define ARGON2_MAX_INTERLEAVE UINT32_C(8)
+
 /* Minimum and maximum digest size in bytes */
 #define ARGON2_MIN_OUTLEN UINT32_C(4)
 #define ARGON2_MAX_OUTLEN UINT32_C(0xFFFFFFFF)
@@ -316,6 +319,22 @@ ARGON2_PUBLIC int argon2id_hash_raw_ex(const uint32_t t_cost,
                                        const size_t hashlen,
                                        void *memory);
 
+/**
+ * Computes @count independent single-lane Argon2id hashes in lockstep, so
+ * that the memory latency of one hash is hidden behind the compression of
+ * the others. Input @i starts at pwd + i * pwdlen and its first @saltlen
+ * bytes are used as salt, output @i is written to hash + i * hashlen and
+ * memory[i] must hold at least m_cost KiB.
+ * @count must be in range 1..ARGON2_MAX_INTERLEAVE.
+ */
+ARGON2_PUBLIC int argon2id_hash_raw_ex_multi(const uint32_t t_cost,
+                                             const uint32_t m_cost,
+                                             const uint32_t count, const void *pwd,
+                                             const size_t pwdlen,
+                                             const size_t saltlen, void *hash,
+                                             const size_t hashlen,
+                                             void *const *memory);
+
 /* generic function underlying the above ones */
 ARGON2_PUBLIC int argon2_hash(const uint32_t t_cost, const uint32_t m_cost,
                               const uint32_t parallelism, const void *pwd,
@@ -54,12 +54,12 @@ size_t argon2_memory_size(uint32_t m_cost, uint32_t parallelism) {
     return memory_blocks * ARGON2_BLOCK_SIZE;
 }
 
-int argon2_ctx_mem(argon2_context *context, argon2_type type, void *memory,
-                   size_t memory_size) {
+static int argon2_instance_init(argon2_instance_t *instance,
+                                argon2_context *context, argon2_type type,
+                                void *memory, size_t memory_size) {
     /* 1. Validate all inputs */
     int result = xmrig_ar2_validate_inputs(context);
     uint32_t memory_blocks, segment_length;
-    argon2_instance_t instance;
 
     if (ARGON2_OK != result) {
         return result;
@@ -79,26 +79,33 @@ int argon2_ctx_mem(argon2_context *context, argon2_type type, void *memory,
         return ARGON2_MEMORY_ALLOCATION_ERROR;
     }
 
-    instance.version = context->version;
-    instance.memory = (block *)memory;
-    instance.passes = context->t_cost;
-    instance.memory_blocks = memory_blocks;
-    instance.segment_length = segment_length;
-    instance.lane_length = segment_length * ARGON2_SYNC_POINTS;
-    instance.lanes = context->lanes;
-    instance.threads = context->threads;
-    instance.type = type;
-    instance.print_internals = !!(context->flags & ARGON2_FLAG_GENKAT);
-    instance.keep_memory = memory != NULL;
-
-    if (instance.threads > instance.lanes) {
-        instance.threads = instance.lanes;
+    instance->version = context->version;
+    instance->memory = (block *)memory;
+    instance->passes = context->t_cost;
+    instance->memory_blocks = memory_blocks;
+    instance->segment_length = segment_length;
+    instance->lane_length = segment_length * ARGON2_SYNC_POINTS;
+    instance->lanes = context->lanes;
+    instance->threads = context->threads;
+    instance->type = type;
+    instance->print_internals = !!(context->flags & ARGON2_FLAG_GENKAT);
+    instance->keep_memory = memory != NULL;
+
+    if (instance->threads > instance->lanes) {
+        instance->threads = instance->lanes;
     }
 
     /* 3. Initialization: Hashing inputs, allocating memory, filling first
      * blocks
      */
-    result = xmrig_ar2_initialize(&instance, context);
+    return xmrig_ar2_initialize(instance, context);
+}
+
+int argon2_ctx_mem(argon2_context *context, argon2_type type, void *memory,
+                   size_t memory_size) {
+    argon2_instance_t instance;
+    int result = argon2_instance_init(&instance, context, type, memory,
+                                      memory_size);
 
     if (ARGON2_OK != result) {
         return result;
@@ -287,6 +294,67 @@ int argon2id_hash_raw_ex(const uint32_t t_cost, const uint32_t m_cost,
     return argon2_ctx_mem(&context, Argon2_id, memory, m_cost * 1024);
 }
 
+int argon2id_hash_raw_ex_multi(const uint32_t t_cost, const uint32_t m_cost,
+                               const uint32_t count, const void *pwd,
+                               const size_t pwdlen, const size_t saltlen,
+                               void *hash, const size_t hashlen,
+                               void *const *memory) {
+    argon2_context contexts[ARGON2_MAX_INTERLEAVE];
+    argon2_instance_t instances[ARGON2_MAX_INTERLEAVE];
+    const argon2_instance_t *ptrs[ARGON2_MAX_INTERLEAVE];
+    uint32_t i, r, s;
+    int result;
+
+    if (count == 0 || count > ARGON2_MAX_INTERLEAVE) {
+        return ARGON2_INCORRECT_PARAMETER;
+    }
+
+    for (i = 0; i < count; ++i) {
+        argon2_context *context = &contexts[i];
+        const uint8_t *input = (const uint8_t *)pwd + i * pwdlen;
+
+        context->out = (uint8_t *)hash + i * hashlen;
+        context->outlen = (uint32_t)hashlen;
+        context->pwd = CONST_CAST(uint8_t *)input;
+        context->pwdlen = (uint32_t)pwdlen;
+        context->salt = CONST_CAST(uint8_t *)input;
+        context->saltlen = (uint32_t)saltlen;
+        context->secret = NULL;
+        context->secretlen = 0;
+        context->ad = NULL;
+        context->adlen = 0;
+        context->t_cost = t_cost;
+        context->m_cost = m_cost;
+        context->lanes = 1;
+        context->threads = 1;
+        context->allocate_cbk = NULL;
+        context->free_cbk = NULL;
+        context->flags = ARGON2_DEFAULT_FLAGS;
+        context->version = ARGON2_VERSION_NUMBER;
+
+        result = argon2_instance_init(&instances[i], context, Argon2_id,
+                                      memory[i], m_cost * 1024);
+        if (ARGON2_OK != result) {
+            return result;
+        }
+
+        ptrs[i] = &instances[i];
+    }
+
+    for (r = 0; r < t_cost; ++r) {
+        for (s = 0; s < ARGON2_SYNC_POINTS; ++s) {
+            argon2_position_t position = { r, 0, (uint8_t)s, 0 };
+            xmrig_ar2_fill_segments(ptrs, count, position);
+        }
+    }
+
+    for (i = 0; i < count; ++i) {
+        xmrig_ar2_finalize(&contexts[i], &instances[i]);
+    }
+
+    return ARGON2_OK;
+}
+
 static int argon2_compare(const uint8_t *b1, const uint8_t *b2, size_t len) {
     size_t i;
     uint8_t d = 0U;
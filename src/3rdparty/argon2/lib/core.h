@@ -209,6 +209,16 @@ void xmrig_ar2_finalize(const argon2_context *context, argon2_instance_t *instan
  */
 void xmrig_ar2_fill_segment(const argon2_instance_t *instance, argon2_position_t position);
 
+/*
+ * Function that fills the same segment of several independent instances with
+ * identical parameters, interleaving them block by block
+ * @param instances Pointers to the instances
+ * @param count Number of instances
+ * @param position Current position
+ * @pre all instances must share the memory geometry, type and version
+ */
+void xmrig_ar2_fill_segments(const argon2_instance_t *const *instances, uint32_t count, argon2_position_t position);
+
 /*
  * Function that fills the entire memory t_cost times based on the first two
  * blocks in each lane
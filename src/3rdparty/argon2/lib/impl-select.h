@@ -8,6 +8,8 @@ typedef struct Argon2_impl {
     int (*check)(void);
     void (*fill_segment)(const argon2_instance_t *instance,
                          argon2_position_t position);
+    void (*fill_segments)(const argon2_instance_t *const *instances,
+                          uint32_t count, argon2_position_t position);
 } argon2_impl;
 
 typedef struct Argon2_impl_list {
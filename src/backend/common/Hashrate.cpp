@@ -18,9 +18,11 @@
  */
 
 
+#include <algorithm>
 #include <cassert>
 #include <memory.h>
 #include <cstdio>
+#include <new>
 
 
 #include "backend/common/Hashrate.h"
@@ -28,6 +30,16 @@
 #include "base/io/json/Json.h"
 #include "base/tools/Chrono.h"
 #include "base/tools/Handle.h"
+#include "crypto/common/portable/mm_malloc.h"
+
+
+namespace xmrig {
+
+
+static const size_t windows[] = { Hashrate::ShortInterval, Hashrate::MediumInterval, Hashrate::LargeInterval };
+
+
+} // namespace xmrig
 
 
 inline static const char *format(double h, char *buf, size_t size)
@@ -44,14 +56,10 @@ inline static const char *format(double h, char *buf, size_t size)
 xmrig::Hashrate::Hashrate(size_t threads) :
     m_threads(threads + 1)
 {
-    m_counts     = new uint64_t*[m_threads];
-    m_timestamps = new uint64_t*[m_threads];
-    m_top        = new uint32_t[m_threads];
-
-    for (size_t i = 0; i < m_threads; i++) {
-        m_counts[i]     = new uint64_t[kBucketSize]();
-        m_timestamps[i] = new uint64_t[kBucketSize]();
-        m_top[i]        = 0;
+    m_samples = static_cast<Samples *>(_mm_malloc(sizeof(Samples) * m_threads, alignof(Samples)));
+
+    for (size_t i = 0; i < m_threads; ++i) {
+        new (&m_samples[i]) Samples();
     }
 
     m_earliestTimestamp = std::numeric_limits<uint64_t>::max();
@@ -61,15 +69,11 @@ xmrig::Hashrate::Hashrate(size_t threads) :
 
 xmrig::Hashrate::~Hashrate()
 {
-    for (size_t i = 0; i < m_threads; i++) {
-        delete [] m_counts[i];
-        delete [] m_timestamps[i];
+    for (size_t i = 0; i < m_threads; ++i) {
+        m_samples[i].~Samples();
     }
 
-    delete [] m_counts;
-    delete [] m_timestamps;
-    delete [] m_top;
-
+    _mm_free(m_samples);
 }
 
 
@@ -122,6 +126,18 @@ rapidjson::Value xmrig::Hashrate::toJSON(size_t threadId, rapidjson::Document &d
 #endif
 
 
+size_t xmrig::Hashrate::window(size_t ms)
+{
+    for (size_t i = 0; i < kWindows; ++i) {
+        if (windows[i] == ms) {
+            return i;
+        }
+    }
+
+    return kWindows;
+}
+
+
 double xmrig::Hashrate::hashrate(size_t index, size_t ms) const
 {
     assert(index < m_threads);
@@ -129,34 +145,72 @@ double xmrig::Hashrate::hashrate(size_t index, size_t ms) const
         return nan("");
     }
 
+    const Samples &samples        = m_samples[index];
+    const uint64_t timeStampLimit = xmrig::Chrono::steadyMSecs() - ms;
+    const size_t w                = window(ms);
+
     uint64_t earliestHashCount = 0;
     uint64_t earliestStamp     = 0;
-    bool haveFullSet           = false;
+    uint64_t lastestStamp      = 0;
+    uint64_t lastestHashCnt    = 0;
+    uint32_t sequence          = 0;
 
-    const uint64_t timeStampLimit = xmrig::Chrono::steadyMSecs() - ms;
-    uint64_t* timestamps          = m_timestamps[index];
-    uint64_t* counts              = m_counts[index];
+    do {
+        sequence = samples.sequence.load(std::memory_order_acquire);
+        if (sequence & 1) {
+            continue;
+        }
 
-    const size_t idx_start  = (m_top[index] - 1) & kBucketMask;
-    size_t idx              = idx_start;
+        earliestStamp = 0;
+        lastestStamp  = 0;
 
-    uint64_t lastestStamp   = timestamps[idx];
-    uint64_t lastestHashCnt = counts[idx];
+        const size_t size    = samples.size;
+        const uint64_t first = samples.added - size;
+        uint64_t pos         = first;
 
-    do {
-        if (timestamps[idx] < timeStampLimit) {
-            haveFullSet = (timestamps[idx] != 0);
-            if (idx != idx_start) {
-                idx = (idx + 1) & kBucketMask;
-                earliestStamp = timestamps[idx];
-                earliestHashCount = counts[idx];
+        // The writer's tail is the first sample inside the window ending at the newest sample, the window ending
+        // now can only start later, usually at the same sample.
+        if (w < kWindows) {
+            pos = std::max(samples.tails[w], first);
+
+            while (pos < samples.added && samples.timestamps[pos & kBucketMask] < timeStampLimit) {
+                ++pos;
             }
-            break;
         }
-        idx = (idx - 1) & kBucketMask;
-    } while (idx != idx_start);
+        else {
+            size_t lo = 0;
+            size_t hi = size;
+
+            while (lo < hi) {
+                const size_t mid = lo + (hi - lo) / 2;
+
+                if (samples.timestamps[(first + mid) & kBucketMask] < timeStampLimit) {
+                    lo = mid + 1;
+                }
+                else {
+                    hi = mid;
+                }
+            }
+
+            pos = first + lo;
+        }
 
-    if (!haveFullSet || earliestStamp == 0 || lastestStamp == 0) {
+        // The window is only complete when at least one sample is older than it, hash counts are cumulative
+        // so the number of hashes in the window is the difference of two samples.
+        if (pos > first && pos < samples.added) {
+            const size_t earliest = pos & kBucketMask;
+            const size_t latest   = (samples.added - 1) & kBucketMask;
+
+            earliestStamp     = samples.timestamps[earliest];
+            earliestHashCount = samples.counts[earliest];
+            lastestStamp      = samples.timestamps[latest];
+            lastestHashCnt    = samples.counts[latest];
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+    } while ((sequence & 1) || samples.sequence.load(std::memory_order_relaxed) != sequence);
+
+    if (earliestStamp == 0 || lastestStamp == 0) {
         return nan("");
     }
 
@@ -173,11 +227,33 @@ double xmrig::Hashrate::hashrate(size_t index, size_t ms) const
 
 void xmrig::Hashrate::addData(size_t index, uint64_t count, uint64_t timestamp)
 {
-    const size_t top         = m_top[index];
-    m_counts[index][top]     = count;
-    m_timestamps[index][top] = timestamp;
+    Samples &samples = m_samples[index];
+
+    samples.sequence.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    const size_t top          = samples.top;
+    samples.counts[top]       = count;
+    samples.timestamps[top]   = timestamp;
+    samples.top               = (top + 1) & kBucketMask;
+
+    if (samples.size < kBucketSize) {
+        samples.size++;
+    }
+
+    const uint64_t first = ++samples.added - samples.size;
+
+    for (size_t i = 0; i < kWindows; ++i) {
+        uint64_t tail = std::max(samples.tails[i], first);
+
+        while (samples.timestamps[tail & kBucketMask] + windows[i] < timestamp) {
+            ++tail;
+        }
+
+        samples.tails[i] = tail;
+    }
 
-    m_top[index] = (top + 1) & kBucketMask;
+    samples.sequence.fetch_add(1, std::memory_order_release);
 
     if (index == 0) {
         if (m_earliestTimestamp == std::numeric_limits<uint64_t>::max()) {
@@ -21,6 +21,7 @@
 #define XMRIG_HASHRATE_H
 
 
+#include <atomic>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
@@ -64,16 +65,37 @@ public:
 #   endif
 
 private:
-    double hashrate(size_t index, size_t ms) const;
-    void addData(size_t index, uint64_t count, uint64_t timestamp);
-
     constexpr static size_t kBucketSize = 2 << 11;
     constexpr static size_t kBucketMask = kBucketSize - 1;
 
+    constexpr static size_t kWindows    = 3;
+
+    // Per-thread ring of samples, timestamps and cumulative hash counts are stored as separate arrays so the
+    // window lookup touches only timestamps. Writers bump the sequence before and after an update (seqlock),
+    // readers retry if it was odd or changed while they were reading. Each thread's samples start on their own
+    // cache line, so a writer never invalidates the sequence of its neighbour.
+    //
+    // For every standard interval the writer keeps the position of the first sample inside the window (tails),
+    // it only moves forward, so both the update and the lookup are amortized O(1).
+    struct alignas(64) Samples
+    {
+        std::atomic<uint32_t> sequence{ 0 };
+        uint32_t top    = 0;
+        uint32_t size   = 0;
+        uint64_t added  = 0;
+        uint64_t tails[kWindows]{};
+
+        uint64_t timestamps[kBucketSize]{};
+        uint64_t counts[kBucketSize]{};
+    };
+
+    static size_t window(size_t ms);
+
+    double hashrate(size_t index, size_t ms) const;
+    void addData(size_t index, uint64_t count, uint64_t timestamp);
+
     size_t m_threads;
-    uint32_t* m_top;
-    uint64_t** m_counts;
-    uint64_t** m_timestamps;
+    Samples *m_samples;
 
     uint64_t m_earliestTimestamp;
     uint64_t m_totalCount;
@@ -0,0 +1,438 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include "backend/common/Profile.h"
+#include "3rdparty/rapidjson/document.h"
+#include "base/api/Metrics.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+
+
+#include <cinttypes>
+#include <mutex>
+
+
+namespace xmrig {
+
+
+std::atomic<bool> Profile::m_enabled{ false };
+
+
+static const char *kNames[Profile::ID_MAX] = { "cn", "argon2", "kawpow", "ghostrider", "randomx", "job_switch", "dataset_init", "verify" };
+
+
+// Latency histogram buckets grow by 4x from 1 us to ~4.2 s, the last one is +Inf.
+static constexpr size_t kBuckets = 13;
+static const char *kBucketBounds[kBuckets] = { "1e-06", "4e-06", "1.6e-05", "6.4e-05", "0.000256", "0.001024", "0.004096", "0.016384", "0.065536", "0.262144", "1.048576", "4.194304", "+Inf" };
+
+
+// First bucket whose bound (1000 << 2k ns) is not below the sample, compared in raw nanoseconds so "le" is a real upper bound
+static inline size_t bucket(uint64_t elapsed)
+{
+    size_t index = 0;
+
+    while (index < kBuckets - 1 && elapsed > (1000ULL << (2 * index))) {
+        ++index;
+    }
+
+    return index;
+}
+
+
+// Counters are written only by the owning thread (plain load/store, no locked instructions), readers may see a sample half way.
+class ProfileCounters
+{
+public:
+    inline uint64_t bucket(size_t id, size_t index) const   { return m_buckets[id][index].load(std::memory_order_relaxed); }
+    inline uint64_t count(size_t id) const                  { return m_count[id].load(std::memory_order_relaxed); }
+    inline uint64_t max(size_t id) const                    { return m_max[id].load(std::memory_order_relaxed); }
+    inline uint64_t time(size_t id) const                   { return m_time[id].load(std::memory_order_relaxed); }
+
+    inline bool isEmpty() const
+    {
+        for (size_t i = 0; i < Profile::ID_MAX; ++i) {
+            if (count(i)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    inline void add(size_t id, uint64_t elapsed)
+    {
+        m_count[id].store(count(id) + 1, std::memory_order_relaxed);
+        m_time[id].store(time(id) + elapsed, std::memory_order_relaxed);
+
+        auto &b = m_buckets[id][xmrig::bucket(elapsed)];
+        b.store(b.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+        if (elapsed > max(id)) {
+            m_max[id].store(elapsed, std::memory_order_relaxed);
+        }
+    }
+
+    inline void clear()
+    {
+        for (size_t i = 0; i < Profile::ID_MAX; ++i) {
+            m_count[i].store(0, std::memory_order_relaxed);
+            m_max[i].store(0, std::memory_order_relaxed);
+            m_time[i].store(0, std::memory_order_relaxed);
+
+            for (auto &b : m_buckets[i]) {
+                b.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    inline void merge(const ProfileCounters &other)
+    {
+        for (size_t i = 0; i < Profile::ID_MAX; ++i) {
+            m_count[i].store(count(i) + other.count(i), std::memory_order_relaxed);
+            m_time[i].store(time(i) + other.time(i), std::memory_order_relaxed);
+
+            for (size_t j = 0; j < kBuckets; ++j) {
+                m_buckets[i][j].store(bucket(i, j) + other.bucket(i, j), std::memory_order_relaxed);
+            }
+
+            if (other.max(i) > max(i)) {
+                m_max[i].store(other.max(i), std::memory_order_relaxed);
+            }
+        }
+    }
+
+    rapidjson::Value toJSON(rapidjson::Document &doc) const
+    {
+        using namespace rapidjson;
+        auto &allocator = doc.GetAllocator();
+
+        Value out(kObjectType);
+
+        for (size_t i = 0; i < Profile::ID_MAX; ++i) {
+            const uint64_t n = count(i);
+            if (!n) {
+                continue;
+            }
+
+            Value scope(kObjectType);
+            scope.AddMember("count",    n, allocator);
+            scope.AddMember("total_ms", static_cast<double>(time(i)) / 1e6, allocator);
+            scope.AddMember("avg_us",   static_cast<double>(time(i)) / 1e3 / static_cast<double>(n), allocator);
+            scope.AddMember("max_us",   static_cast<double>(max(i)) / 1e3, allocator);
+
+            out.AddMember(StringRef(kNames[i]), scope, allocator);
+        }
+
+        return out;
+    }
+
+private:
+    std::atomic<uint64_t> m_buckets[Profile::ID_MAX][kBuckets]{};
+    std::atomic<uint64_t> m_count[Profile::ID_MAX]{};
+    std::atomic<uint64_t> m_max[Profile::ID_MAX]{};
+    std::atomic<uint64_t> m_time[Profile::ID_MAX]{};
+};
+
+
+// Profile::reset() only bumps the generation, the owner clears its own counters on the next sample, so a slot
+// is never written by two threads. Until then readers skip the slot, it holds samples from before the reset.
+class ProfileSlot : public ProfileCounters
+{
+public:
+    std::atomic<bool> used{ false };
+    std::atomic<uint64_t> generation{ 0 };
+    uint64_t thread = 0;
+
+private:
+    char m_pad[64]{};
+};
+
+
+class ProfileThread
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE(ProfileThread)
+
+    ProfileThread() = default;
+    ~ProfileThread();
+
+    ProfileSlot *slot();
+
+private:
+    bool m_ready        = false;
+    ProfileSlot *m_slot = nullptr;
+};
+
+
+static constexpr size_t kMaxSlots = 256;
+static ProfileCounters retired;
+static ProfileSlot slots[kMaxSlots];
+static std::mutex mutex;
+static std::atomic<uint64_t> dropped{ 0 };
+static std::atomic<uint64_t> generation{ 0 };
+static uint64_t threadSequence = 0;
+static thread_local ProfileThread profileThread;
+
+
+static inline bool isCurrent(const ProfileSlot &slot)
+{
+    return slot.generation.load(std::memory_order_relaxed) == generation.load(std::memory_order_relaxed);
+}
+
+
+} // namespace xmrig
+
+
+xmrig::ProfileThread::~ProfileThread()
+{
+    if (!m_slot) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (isCurrent(*m_slot)) {
+        retired.merge(*m_slot);
+    }
+
+    m_slot->clear();
+    m_slot->used.store(false, std::memory_order_release);
+}
+
+
+xmrig::ProfileSlot *xmrig::ProfileThread::slot()
+{
+    if (m_ready) {
+        return m_slot;
+    }
+
+    m_ready = true;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (auto &slot : slots) {
+        if (!slot.used.load(std::memory_order_relaxed)) {
+            slot.used.store(true, std::memory_order_relaxed);
+            slot.generation.store(generation.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            slot.thread = threadSequence++;
+            m_slot      = &slot;
+
+            break;
+        }
+    }
+
+    return m_slot;
+}
+
+
+const char *xmrig::Profile::name(Id id)
+{
+    return id < ID_MAX ? kNames[id] : "unknown";
+}
+
+
+xmrig::Profile::Id xmrig::Profile::id(const Algorithm &algorithm)
+{
+    switch (algorithm.family()) {
+    case Algorithm::ARGON2:
+        return ARGON2;
+
+    case Algorithm::KAWPOW:
+        return KAWPOW;
+
+    case Algorithm::GHOSTRIDER:
+        return GHOSTRIDER;
+
+    case Algorithm::RANDOM_X:
+        return RANDOMX;
+
+    default:
+        break;
+    }
+
+    return CN;
+}
+
+
+rapidjson::Value xmrig::Profile::toJSON(rapidjson::Document &doc)
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    Value out(kObjectType);
+    Value threads(kArrayType);
+    ProfileCounters total;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        total.merge(retired);
+
+        for (const auto &slot : slots) {
+            if (!slot.used.load(std::memory_order_relaxed) || !isCurrent(slot) || slot.isEmpty()) {
+                continue;
+            }
+
+            total.merge(slot);
+
+            Value thread(kObjectType);
+            thread.AddMember("id",      slot.thread, allocator);
+            thread.AddMember("scopes",  slot.toJSON(doc), allocator);
+
+            threads.PushBack(thread, allocator);
+        }
+    }
+
+    out.AddMember("enabled",    isEnabled(), allocator);
+    out.AddMember("dropped",    dropped.load(std::memory_order_relaxed), allocator);
+    out.AddMember("total",      total.toJSON(doc), allocator);
+    out.AddMember("threads",    threads, allocator);
+
+    return out;
+}
+
+
+#ifdef XMRIG_FEATURE_API
+void xmrig::Profile::toMetrics(Metrics &metrics)
+{
+    ProfileCounters total;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        total.merge(retired);
+
+        for (const auto &slot : slots) {
+            if (slot.used.load(std::memory_order_relaxed) && isCurrent(slot)) {
+                total.merge(slot);
+            }
+        }
+    }
+
+    metrics.family("xmrig_profile_enabled", Metrics::kGauge, "Runtime profiler state, the histogram below is only filled while it is enabled.");
+    metrics.add("xmrig_profile_enabled", static_cast<uint64_t>(isEnabled()));
+
+    if (total.isEmpty()) {
+        return;
+    }
+
+    metrics.family("xmrig_profile_seconds", Metrics::kHistogram, "Time spent per call in hot paths, all threads combined.", "seconds");
+
+    for (size_t i = 0; i < ID_MAX; ++i) {
+        const uint64_t n = total.count(i);
+        if (!n) {
+            continue;
+        }
+
+        uint64_t cumulative = 0;
+
+        for (size_t j = 0; j < kBuckets; ++j) {
+            cumulative += total.bucket(i, j);
+            metrics.add("xmrig_profile_seconds_bucket", cumulative, { { "scope", kNames[i] }, { "le", kBucketBounds[j] } });
+        }
+
+        metrics.add("xmrig_profile_seconds_count", n, { { "scope", kNames[i] } });
+        metrics.add("xmrig_profile_seconds_sum", static_cast<double>(total.time(i)) / 1e9, { { "scope", kNames[i] } });
+    }
+}
+#endif
+
+
+void xmrig::Profile::add(Id id, uint64_t elapsed)
+{
+    auto slot = profileThread.slot();
+    if (!slot) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+
+        return;
+    }
+
+    const uint64_t current = generation.load(std::memory_order_relaxed);
+    if (slot->generation.load(std::memory_order_relaxed) != current) {
+        slot->clear();
+        slot->generation.store(current, std::memory_order_relaxed);
+    }
+
+    slot->add(id, elapsed);
+}
+
+
+void xmrig::Profile::print()
+{
+    ProfileCounters total;
+    size_t threads = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        total.merge(retired);
+
+        for (const auto &slot : slots) {
+            if (slot.used.load(std::memory_order_relaxed) && isCurrent(slot) && !slot.isEmpty()) {
+                total.merge(slot);
+                ++threads;
+            }
+        }
+    }
+
+    if (total.isEmpty()) {
+        LOG_INFO("%s " YELLOW("no samples collected"), Tags::profiler());
+
+        return;
+    }
+
+    LOG_INFO("%s " WHITE_BOLD("| %-12s | %12s | %12s | %12s | %12s |") " threads " CYAN_BOLD("%zu"), Tags::profiler(), "SCOPE", "COUNT", "TOTAL ms", "AVG us", "MAX us", threads);
+
+    for (size_t i = 0; i < ID_MAX; ++i) {
+        const uint64_t n = total.count(i);
+        if (!n) {
+            continue;
+        }
+
+        LOG_INFO("%s | %-12s | %12" PRIu64 " | %12.1f | %12.2f | %12.2f |",
+                 Tags::profiler(),
+                 kNames[i],
+                 n,
+                 static_cast<double>(total.time(i)) / 1e6,
+                 static_cast<double>(total.time(i)) / 1e3 / static_cast<double>(n),
+                 static_cast<double>(total.max(i)) / 1e3
+                 );
+    }
+}
+
+
+void xmrig::Profile::reset()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    retired.clear();
+    dropped.store(0, std::memory_order_relaxed);
+    generation.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+void xmrig::Profile::setEnabled(bool enabled)
+{
+    if (m_enabled.exchange(enabled) == enabled) {
+        return;
+    }
+
+    LOG_INFO("%s %s", Tags::profiler(), enabled ? GREEN_BOLD("sampling enabled") : YELLOW_BOLD("sampling disabled"));
+}
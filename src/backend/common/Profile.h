@@ -0,0 +1,105 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef XMRIG_PROFILE_H
+#define XMRIG_PROFILE_H
+
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+
+#include "3rdparty/rapidjson/fwd.h"
+#include "base/crypto/Algorithm.h"
+#include "base/tools/Object.h"
+
+
+namespace xmrig {
+
+
+class Metrics;
+
+
+// Runtime profiler: per-thread time and call counters for the hot paths, can be switched on and off without
+// a rebuild (config, API or console). While disabled each sample costs a single relaxed atomic load.
+// Fine grained RandomX internals are still covered by PROFILE_SCOPE from crypto/rx/Profiler.h (WITH_PROFILING).
+class Profile
+{
+public:
+    enum Id : uint32_t {
+        CN,
+        ARGON2,
+        KAWPOW,
+        GHOSTRIDER,
+        RANDOMX,
+        JOB_SWITCH,
+        DATASET_INIT,
+        VERIFY,
+        ID_MAX
+    };
+
+    static inline bool isEnabled()                  { return m_enabled.load(std::memory_order_relaxed); }
+    static inline uint64_t now()                    { return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count()); }
+
+    static const char *name(Id id);
+    static Id id(const Algorithm &algorithm);
+    static rapidjson::Value toJSON(rapidjson::Document &doc);
+    static void add(Id id, uint64_t elapsed);
+
+#   ifdef XMRIG_FEATURE_API
+    static void toMetrics(Metrics &metrics);
+#   endif
+
+    static void print();
+    static void reset();
+    static void setEnabled(bool enabled);
+
+private:
+    static std::atomic<bool> m_enabled;
+};
+
+
+class ProfileSample
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(ProfileSample)
+
+    inline explicit ProfileSample(Profile::Id id) :
+        m_id(id),
+        m_start(Profile::isEnabled() ? Profile::now() : 0)
+    {}
+
+    inline ~ProfileSample()
+    {
+        if (m_start) {
+            Profile::add(m_id, Profile::now() - m_start);
+        }
+    }
+
+private:
+    const Profile::Id m_id;
+    const uint64_t m_start;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_PROFILE_H */
@@ -23,6 +23,9 @@
 #include "backend/common/interfaces/IWorker.h"
 
 
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <thread>
 
 
@@ -44,18 +47,18 @@ class Thread
 public:
     XMRIG_DISABLE_COPY_MOVE_DEFAULT(Thread)
 
-    inline Thread(IBackend *backend, size_t id, const T &config) : m_id(id), m_config(config), m_backend(backend) {}
+    inline Thread(IBackend *backend, size_t id, const T &config) : m_id(id), m_backend(backend), m_config(new T(config)) {}
 
 #   ifdef XMRIG_OS_APPLE
-    inline ~Thread() { pthread_join(m_thread, nullptr); delete m_worker; }
+    inline ~Thread() { exit(); pthread_join(m_thread, nullptr); delete m_retired; delete m_worker; }
 
     inline void start(void *(*callback)(void *))
     {
-        if (m_config.affinity >= 0) {
+        if (m_config->affinity >= 0) {
             pthread_create_suspended_np(&m_thread, nullptr, callback, this);
 
             mach_port_t mach_thread              = pthread_mach_thread_np(m_thread);
-            thread_affinity_policy_data_t policy = { static_cast<integer_t>(m_config.affinity + 1) };
+            thread_affinity_policy_data_t policy = { static_cast<integer_t>(m_config->affinity + 1) };
 
             thread_policy_set(mach_thread, THREAD_AFFINITY_POLICY, reinterpret_cast<thread_policy_t>(&policy), THREAD_AFFINITY_POLICY_COUNT);
             thread_resume(mach_thread);
@@ -65,22 +68,72 @@ public:
         }
     }
 #   else
-    inline ~Thread() { m_thread.join(); delete m_worker; }
+    inline ~Thread() { exit(); m_thread.join(); delete m_retired; delete m_worker; }
 
     inline void start(void *(*callback)(void *))    { m_thread = std::thread(callback, this); }
 #   endif
 
-    inline const T &config() const                  { return m_config; }
+    inline const T &config() const                  { return *m_config; }
     inline IBackend *backend() const                { return m_backend; }
     inline IWorker *worker() const                  { return m_worker; }
     inline size_t id() const                        { return m_id; }
     inline void setWorker(IWorker *worker)          { m_worker = worker; }
 
+    // Called from the thread itself after the worker returns, blocks until resume() or destruction.
+    inline bool park()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_parked = true;
+        m_cv.notify_all();
+        m_cv.wait(lock, [this] { return !m_parked || m_exit; });
+
+        if (m_exit) {
+            return false;
+        }
+
+        IWorker *retired = m_retired;
+        m_retired        = nullptr;
+        lock.unlock();
+
+        delete retired;
+
+        return true;
+    }
+
+    inline void waitParked()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.wait(lock, [this] { return m_parked; });
+    }
+
+    // The previous worker is destroyed by the thread itself, right before the new one is created, so its scratchpad can be reused.
+    inline void resume(const T &config)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_config.reset(new T(config));
+        m_retired = m_worker;
+        m_worker  = nullptr;
+        m_parked  = false;
+        m_cv.notify_all();
+    }
+
 private:
-    const size_t m_id    = 0;
-    const T m_config;
+    inline void exit()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_exit = true;
+        m_cv.notify_all();
+    }
+
+    bool m_exit             = false;
+    bool m_parked           = false;
+    const size_t m_id       = 0;
     IBackend *m_backend;
+    IWorker *m_retired      = nullptr;
     IWorker *m_worker       = nullptr;
+    std::condition_variable m_cv;
+    std::mutex m_mutex;
+    std::unique_ptr<T> m_config;
 
     #ifdef XMRIG_OS_APPLE
     pthread_t m_thread{};
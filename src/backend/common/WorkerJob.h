@@ -26,7 +26,9 @@
 #define XMRIG_WORKERJOB_H
 
 
+#include <algorithm>
 #include <cstring>
+#include <memory>
 
 
 #include "base/net/stratum/Job.h"
@@ -41,42 +43,57 @@ template<size_t N>
 class WorkerJob
 {
 public:
-    inline const Job &currentJob() const    { return m_jobs[index()]; }
+    inline const Job &currentJob() const    { return *m_jobs[index()]; }
     inline uint32_t *nonce(size_t i = 0)    { return reinterpret_cast<uint32_t*>(blob() + (i * currentJob().size()) + nonceOffset()); }
     inline uint64_t sequence() const        { return m_sequence; }
     inline uint8_t *blob()                  { return m_blobs[index()]; }
     inline uint8_t index() const            { return m_index; }
+    inline void setNode(uint32_t node)      { m_node = node; }
 
+    // True when the next nextRound() call has to take a new nonce lease.
+    inline bool isLeaseEnd(uint32_t roundSize) const { return m_left[index()] < 2 * roundSize; }
 
-    inline void add(const Job &job, uint32_t reserveCount, Nonce::Backend backend)
+
+    // The job is shared and immutable, only the blob is copied into this worker's nonce lanes.
+    // Returns true if the worker switched to another job, false if it keeps mining the current one.
+    inline bool add(const std::shared_ptr<const Job> &job, uint32_t reserveCount, Nonce::Backend backend)
     {
         m_sequence = Nonce::sequence(backend);
 
-        if (currentJob() == job) {
-            return;
+        if (m_jobs[index()] == job || currentJob() == *job) {
+            return false;
         }
 
-        if (index() == 1 && job.index() == 0 && job == m_jobs[0]) {
+        if (index() == 1 && job->index() == 0 && *job == *m_jobs[0]) {
             m_index = 0;
-            return;
+            return true;
         }
 
-        save(job, reserveCount, backend);
+        save(job, reserveCount);
+
+        return true;
     }
 
 
     inline bool nextRound(uint32_t rounds, uint32_t roundSize)
     {
-        m_rounds[index()]++;
+        if (isLeaseEnd(roundSize)) {
+            uint32_t left = rounds * roundSize;
 
-        if ((m_rounds[index()] & (rounds - 1)) == 0) {
             for (size_t i = 0; i < N; ++i) {
-                if (!Nonce::next(index(), nonce(i), rounds * roundSize, nonceMask())) {
+                uint32_t count = rounds * roundSize;
+                if (!reserve(nonce(i), &count)) {
                     return false;
                 }
+
+                left = std::min(left, count);
             }
+
+            m_left[index()] = left;
         }
         else {
+            m_left[index()] -= roundSize;
+
             for (size_t i = 0; i < N; ++i) {
                 writeUnaligned(nonce(i), readUnaligned(nonce(i)) + roundSize);
             }
@@ -92,26 +109,44 @@ public:
 private:
     inline uint64_t nonceMask() const     { return m_nonce_mask[index()]; }
 
-    inline void save(const Job &job, uint32_t reserveCount, Nonce::Backend backend)
+    // Per node blocks may hand out a shorter lease, count is updated to the number of nonces actually reserved.
+    inline bool reserve(uint32_t *nonce, uint32_t *count)
     {
-        m_index           = job.index();
-        const size_t size = job.size();
-        m_jobs[index()]   = job;
-        m_rounds[index()] = 0;
-        m_nonce_mask[index()] = job.nonceMask();
+        return m_node < 0 ? Nonce::next(index(), nonce, *count, nonceMask()) : Nonce::next(index(), nonce, count, nonceMask(), static_cast<uint32_t>(m_node));
+    }
 
-        m_jobs[index()].setBackend(backend);
+    inline void save(const std::shared_ptr<const Job> &job, uint32_t reserveCount)
+    {
+        m_index           = job->index();
+        const size_t size = job->size();
+        m_jobs[index()]   = job;
+        m_owned[index()].reset();
+        m_left[index()]   = reserveCount;
+        m_nonce_mask[index()] = job->nonceMask();
 
         for (size_t i = 0; i < N; ++i) {
-            memcpy(m_blobs[index()] + (i * size), job.blob(), size);
-            Nonce::next(index(), nonce(i), reserveCount, nonceMask());
+            uint32_t count = reserveCount;
+            memcpy(m_blobs[index()] + (i * size), job->blob(), size);
+            reserve(nonce(i), &count);
+
+            m_left[index()] = std::min(m_left[index()], count);
         }
     }
 
 
+    static inline std::shared_ptr<const Job> empty()
+    {
+        static const std::shared_ptr<const Job> job = std::make_shared<Job>();
+
+        return job;
+    }
+
+
     alignas(8) uint8_t m_blobs[2][Job::kMaxBlobSize * N]{};
-    Job m_jobs[2];
-    uint32_t m_rounds[2] = { 0, 0 };
+    std::shared_ptr<const Job> m_jobs[2] = { empty(), empty() };
+    std::shared_ptr<Job> m_owned[2];
+    int64_t m_node       = -1;
+    uint32_t m_left[2]   = { 0, 0 };
     uint64_t m_nonce_mask[2] = { 0, 0 };
     uint64_t m_sequence  = 0;
     uint8_t m_index      = 0;
@@ -128,19 +163,28 @@ inline uint32_t *xmrig::WorkerJob<1>::nonce(size_t)
 template<>
 inline bool xmrig::WorkerJob<1>::nextRound(uint32_t rounds, uint32_t roundSize)
 {
-    m_rounds[index()]++;
-
     uint32_t* n = nonce();
 
-    if ((m_rounds[index()] & (rounds - 1)) == 0) {
-        if (!Nonce::next(index(), n, rounds * roundSize, nonceMask())) {
+    if (isLeaseEnd(roundSize)) {
+        uint32_t count = rounds * roundSize;
+        if (!reserve(n, &count)) {
             return false;
         }
+
+        m_left[index()] = count;
+
         if (nonceSize() == sizeof(uint64_t)) {
-            writeUnaligned(m_jobs[index()].nonce() + 1, readUnaligned(n + 1));
+            // Results read the upper nonce half from the job blob, so 64-bit nonces need a private copy of the job.
+            if (!m_owned[index()]) {
+                m_owned[index()] = std::make_shared<Job>(currentJob());
+                m_jobs[index()]  = m_owned[index()];
+            }
+
+            writeUnaligned(m_owned[index()]->nonce() + 1, readUnaligned(n + 1));
         }
     }
     else {
+        m_left[index()] -= roundSize;
         writeUnaligned(n, readUnaligned(n) + roundSize);
     }
 
@@ -149,17 +193,16 @@ inline bool xmrig::WorkerJob<1>::nextRound(uint32_t rounds, uint32_t roundSize)
 
 
 template<>
-inline void xmrig::WorkerJob<1>::save(const Job &job, uint32_t reserveCount, Nonce::Backend backend)
+inline void xmrig::WorkerJob<1>::save(const std::shared_ptr<const Job> &job, uint32_t reserveCount)
 {
-    m_index           = job.index();
+    m_index           = job->index();
     m_jobs[index()]   = job;
-    m_rounds[index()] = 0;
-    m_nonce_mask[index()] = job.nonceMask();
-
-    m_jobs[index()].setBackend(backend);
+    m_owned[index()].reset();
+    m_nonce_mask[index()] = job->nonceMask();
 
-    memcpy(blob(), job.blob(), job.size());
-    Nonce::next(index(), nonce(), reserveCount, nonceMask());
+    memcpy(blob(), job->blob(), job->size());
+    m_left[index()]   = reserveCount;
+    reserve(nonce(), &m_left[index()]);
 }
 
 
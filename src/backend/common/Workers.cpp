@@ -149,6 +149,50 @@ void xmrig::Workers<T>::stop()
 }
 
 
+template<class T>
+bool xmrig::Workers<T>::park(const std::vector<T> &data)
+{
+    if (m_workers.empty() || m_workers.size() != data.size() || d_ptr->benchmark) {
+        return false;
+    }
+
+    for (size_t i = 0; i < data.size(); ++i) {
+        if (m_workers[i]->config().affinity != data[i].affinity) {
+            return false;
+        }
+    }
+
+#   ifdef XMRIG_MINER_PROJECT
+    Nonce::stop(T::backend());
+#   endif
+
+    for (Thread<T> *worker : m_workers) {
+        worker->waitParked();
+    }
+
+    d_ptr->hashrate.reset();
+
+    return true;
+}
+
+
+template<class T>
+void xmrig::Workers<T>::resume(const std::vector<T> &data)
+{
+    assert(m_workers.size() == data.size());
+
+    d_ptr->hashrate = std::make_shared<Hashrate>(m_workers.size());
+
+#   ifdef XMRIG_MINER_PROJECT
+    Nonce::touch(T::backend());
+#   endif
+
+    for (size_t i = 0; i < m_workers.size(); ++i) {
+        m_workers[i]->resume(data[i]);
+    }
+}
+
+
 #ifdef XMRIG_FEATURE_BENCHMARK
 template<class T>
 void xmrig::Workers<T>::start(const std::vector<T> &data, const std::shared_ptr<Benchmark> &benchmark)
@@ -177,22 +221,24 @@ void *xmrig::Workers<T>::onReady(void *arg)
 {
     auto handle = static_cast<Thread<T>* >(arg);
 
-    IWorker *worker = create(handle);
-    assert(worker != nullptr);
+    do {
+        IWorker *worker = create(handle);
+        assert(worker != nullptr);
 
-    if (!worker || !worker->selfTest()) {
-        LOG_ERR("%s " RED("thread ") RED_BOLD("#%zu") RED(" self-test failed"), T::tag(), worker ? worker->id() : 0);
+        if (!worker || !worker->selfTest()) {
+            LOG_ERR("%s " RED("thread ") RED_BOLD("#%zu") RED(" self-test failed"), T::tag(), worker ? worker->id() : 0);
 
-        handle->backend()->start(worker, false);
-        delete worker;
+            handle->backend()->start(worker, false);
+            delete worker;
 
-        return nullptr;
-    }
+            continue;
+        }
 
-    assert(handle->backend() != nullptr);
+        assert(handle->backend() != nullptr);
 
-    handle->setWorker(worker);
-    handle->backend()->start(worker, true);
+        handle->setWorker(worker);
+        handle->backend()->start(worker, true);
+    } while (handle->park());
 
     return nullptr;
 }
@@ -56,9 +56,11 @@ public:
 
     inline void start(const std::vector<T> &data)   { start(data, true); }
 
+    bool park(const std::vector<T> &data);
     bool tick(uint64_t ticks);
     const Hashrate *hashrate() const;
     void jobEarlyNotification(const Job &job);
+    void resume(const std::vector<T> &data);
     void setBackend(IBackend *backend);
     void stop();
 
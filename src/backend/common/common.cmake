@@ -6,6 +6,7 @@ set(HEADERS_BACKEND_COMMON
     src/backend/common/interfaces/IRxStorage.h
     src/backend/common/interfaces/IWorker.h
     src/backend/common/misc/PciTopology.h
+    src/backend/common/Profile.h
     src/backend/common/Thread.h
     src/backend/common/Threads.h
     src/backend/common/Worker.h
@@ -15,6 +16,7 @@ set(HEADERS_BACKEND_COMMON
 
 set(SOURCES_BACKEND_COMMON
     src/backend/common/Hashrate.cpp
+    src/backend/common/Profile.cpp
     src/backend/common/Threads.cpp
     src/backend/common/Worker.cpp
     src/backend/common/Workers.cpp
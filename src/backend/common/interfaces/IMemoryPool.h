@@ -39,8 +39,10 @@ public:
     virtual ~IMemoryPool()  = default;
 
     virtual bool isHugePages(uint32_t node) const       = 0;
+    virtual size_t capacity() const                     = 0;
+    virtual size_t used() const                         = 0;
     virtual uint8_t *get(size_t size, uint32_t node)    = 0;
-    virtual void release(uint32_t node)                 = 0;
+    virtual void release(uint8_t *ptr, uint32_t node)   = 0;
 };
 
 
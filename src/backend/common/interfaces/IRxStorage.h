@@ -46,10 +46,11 @@ public:
     IRxStorage()            = default;
     virtual ~IRxStorage()   = default;
 
-    virtual bool isAllocated() const                                                                                            = 0;
-    virtual HugePagesInfo hugePages() const                                                                                     = 0;
-    virtual RxDataset *dataset(const Job &job, uint32_t nodeId) const                                                           = 0;
-    virtual void init(const RxSeed &seed, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority) = 0;
+    virtual bool isAllocated() const                                                                                                  = 0;
+    virtual bool precompute(const RxSeed &seed, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority) = 0;
+    virtual HugePagesInfo hugePages() const                                                                                           = 0;
+    virtual RxDataset *dataset(const Job &job, uint32_t nodeId) const                                                                 = 0;
+    virtual void init(const RxSeed &seed, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority)       = 0;
 };
 
 
@@ -40,6 +40,7 @@
 
 #ifdef XMRIG_FEATURE_API
 #   include "base/api/interfaces/IApiRequest.h"
+#   include "base/api/Metrics.h"
 #endif
 
 
@@ -48,6 +49,11 @@
 #endif
 
 
+#ifdef XMRIG_FEATURE_ASM
+#   include "crypto/cn/r/CnRCache.h"
+#endif
+
+
 #ifdef XMRIG_FEATURE_BENCHMARK
 #   include "backend/common/benchmark/Benchmark.h"
 #   include "backend/common/benchmark/BenchState.h"
@@ -111,7 +117,9 @@ public:
             return;
         }
 
-        LOG_INFO("%s" GREEN_BOLD(" READY") " threads %s%zu/%zu (%zu)" CLEAR " huge pages %s%1.0f%% %zu/%zu" CLEAR " memory " CYAN_BOLD("%zu KB") BLACK_BOLD(" (%" PRIu64 " ms)"),
+        const auto arena = VirtualMemory::poolUsage();
+
+        LOG_INFO("%s" GREEN_BOLD(" READY") " threads %s%zu/%zu (%zu)" CLEAR " huge pages %s%1.0f%% %zu/%zu" CLEAR " memory " CYAN_BOLD("%zu KB") " arena " CYAN("%zu/%zu KB") BLACK_BOLD(" (%" PRIu64 " ms)"),
                  Tags::cpu(),
                  m_errors == 0 ? CYAN_BOLD_S : YELLOW_BOLD_S,
                  m_totalStarted, std::max(m_totalStarted, m_threads), m_ways,
@@ -119,6 +127,7 @@ public:
                  m_hugePages.percent(),
                  m_hugePages.allocated, m_hugePages.total,
                  memory() / 1024,
+                 arena.first / 1024, arena.second / 1024,
                  Chrono::steadyMSecs() - m_ts
                  );
     }
@@ -142,7 +151,7 @@ public:
     inline explicit CpuBackendPrivate(Controller *controller) : controller(controller)   {}
 
 
-    inline void start()
+    inline void start(bool resume = false)
     {
         LOG_INFO("%s use profile " BLUE_BG(WHITE_BOLD_S " %s ") WHITE_BOLD_S " (" CYAN_BOLD("%zu") WHITE_BOLD(" thread%s)") " scratchpad " CYAN_BOLD("%zu KB"),
                  Tags::cpu(),
@@ -154,6 +163,10 @@ public:
 
         status.start(threads, algo.l3());
 
+        if (resume) {
+            return workers.resume(threads);
+        }
+
 #       ifdef XMRIG_FEATURE_BENCHMARK
         workers.start(threads, benchmark);
 #       else
@@ -170,7 +183,7 @@ public:
     }
 
 
-    rapidjson::Value hugePages(int version, rapidjson::Document &doc) const
+    HugePagesInfo hugePages() const
     {
         HugePagesInfo pages;
 
@@ -186,6 +199,13 @@ public:
 
         mutex.unlock();
 
+        return pages;
+    }
+
+
+    rapidjson::Value hugePages(int version, rapidjson::Document &doc) const
+    {
+        const HugePagesInfo pages = hugePages();
         rapidjson::Value hugepages;
 
         if (version > 1) {
@@ -349,10 +369,18 @@ void xmrig::CpuBackend::setJob(const Job &job)
         return stop();
     }
 
+#   ifdef XMRIG_FEATURE_ASM
+    // Compile CN-R programs for this and the next height here, so workers only copy them.
+    CnRCache::prefetch(job.algorithm(), job.height());
+#   endif
+
     const auto &cpu = d_ptr->controller->config()->cpu();
 
+    // RandomX VMs are bound to the variant's parameters, another variant needs new workers even with the same threads
+    const bool reuse = d_ptr->algo == job.algorithm() || job.algorithm().family() != Algorithm::RANDOM_X;
+
     auto threads = cpu.get(d_ptr->controller->miner(), job.algorithm());
-    if (!d_ptr->threads.empty() && d_ptr->threads.size() == threads.size() && std::equal(d_ptr->threads.begin(), d_ptr->threads.end(), threads.begin())) {
+    if (reuse && !d_ptr->threads.empty() && d_ptr->threads.size() == threads.size() && std::equal(d_ptr->threads.begin(), d_ptr->threads.end(), threads.begin())) {
         return;
     }
 
@@ -365,6 +393,13 @@ void xmrig::CpuBackend::setJob(const Job &job)
         return stop();
     }
 
+    // Keep the pinned threads alive and only recreate their workers when the thread layout is the same.
+    if (cpu.isPersistentThreads() && d_ptr->workers.park(threads)) {
+        d_ptr->threads = std::move(threads);
+
+        return d_ptr->start(true);
+    }
+
     stop();
 
 #   ifdef XMRIG_FEATURE_BENCHMARK
@@ -439,6 +474,12 @@ rapidjson::Value xmrig::CpuBackend::toJSON(rapidjson::Document &doc) const
     out.AddMember("hugepages", d_ptr->hugePages(2, doc), allocator);
     out.AddMember("memory",    static_cast<uint64_t>(d_ptr->algo.isValid() ? (d_ptr->ways() * d_ptr->algo.l3()) : 0), allocator);
 
+    const auto usage = VirtualMemory::poolUsage();
+    Value arena(kArrayType);
+    arena.PushBack(static_cast<uint64_t>(usage.first), allocator);
+    arena.PushBack(static_cast<uint64_t>(usage.second), allocator);
+    out.AddMember("arena",     arena, allocator);
+
     if (d_ptr->threads.empty() || !hashrate()) {
         return out;
     }
@@ -470,6 +511,19 @@ void xmrig::CpuBackend::handleRequest(IApiRequest &request)
     if (request.type() == IApiRequest::REQ_SUMMARY) {
         request.reply().AddMember("hugepages", d_ptr->hugePages(request.version(), request.doc()), request.doc().GetAllocator());
     }
+    else if (request.type() == IApiRequest::REQ_METRICS) {
+        auto &metrics               = request.metrics();
+        const HugePagesInfo pages   = d_ptr->hugePages();
+
+        metrics.family("xmrig_hugepages", Metrics::kGauge, "Huge pages used by CPU scratchpads and the RandomX dataset.");
+        metrics.add("xmrig_hugepages", static_cast<uint64_t>(pages.allocated), { { "backend", "cpu" }, { "state", "allocated" } });
+        metrics.add("xmrig_hugepages", static_cast<uint64_t>(pages.total), { { "backend", "cpu" }, { "state", "total" } });
+
+#       ifdef XMRIG_ALGO_RANDOMX
+        metrics.family("xmrig_randomx_dataset_pending", Metrics::kGauge, "RandomX dataset (re)initialization is in progress.");
+        metrics.add("xmrig_randomx_dataset_pending", static_cast<uint64_t>(Rx::isPending()));
+#       endif
+    }
 }
 #endif
 
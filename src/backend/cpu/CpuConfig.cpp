@@ -34,6 +34,7 @@ const char *CpuConfig::kHugePagesJit        = "huge-pages-jit";
 const char *CpuConfig::kHwAes               = "hw-aes";
 const char *CpuConfig::kMaxThreadsHint      = "max-threads-hint";
 const char *CpuConfig::kMemoryPool          = "memory-pool";
+const char *CpuConfig::kPersistentThreads   = "persistent-threads";
 const char *CpuConfig::kPriority            = "priority";
 const char *CpuConfig::kYield               = "yield";
 
@@ -71,6 +72,7 @@ rapidjson::Value xmrig::CpuConfig::toJSON(rapidjson::Document &doc) const
     obj.AddMember(StringRef(kPriority),     priority() != -1 ? Value(priority()) : Value(kNullType), allocator);
     obj.AddMember(StringRef(kMemoryPool),   m_memoryPool < 1 ? Value(m_memoryPool < 0) : Value(m_memoryPool), allocator);
     obj.AddMember(StringRef(kYield),        m_yield, allocator);
+    obj.AddMember(StringRef(kPersistentThreads), m_persistentThreads, allocator);
 
     if (m_threads.isEmpty()) {
         obj.AddMember(StringRef(kMaxThreadsHint), m_limit, allocator);
@@ -134,6 +136,7 @@ void xmrig::CpuConfig::read(const rapidjson::Value &value)
         m_hugePagesJit = Json::getBool(value, kHugePagesJit, m_hugePagesJit);
         m_limit        = Json::getUint(value, kMaxThreadsHint, m_limit);
         m_yield        = Json::getBool(value, kYield, m_yield);
+        m_persistentThreads = Json::getBool(value, kPersistentThreads, m_persistentThreads);
 
         setAesMode(Json::getValue(value, kHwAes));
         setHugePages(Json::getValue(value, kHugePages));
@@ -45,6 +45,7 @@ public:
     static const char *kHwAes;
     static const char *kMaxThreadsHint;
     static const char *kMemoryPool;
+    static const char *kPersistentThreads;
     static const char *kPriority;
     static const char *kYield;
 
@@ -67,6 +68,7 @@ public:
     inline bool isEnabled() const                       { return m_enabled; }
     inline bool isHugePages() const                     { return m_hugePageSize > 0; }
     inline bool isHugePagesJit() const                  { return m_hugePagesJit; }
+    inline bool isPersistentThreads() const             { return m_persistentThreads; }
     inline bool isShouldSave() const                    { return m_shouldSave; }
     inline bool isYield() const                         { return m_yield; }
     inline const Assembly &assembly() const             { return m_assembly; }
@@ -91,6 +93,7 @@ private:
     Assembly m_assembly;
     bool m_enabled          = true;
     bool m_hugePagesJit     = false;
+    bool m_persistentThreads = true;
     bool m_shouldSave       = false;
     bool m_yield            = true;
     int m_memoryPool        = 0;
@@ -16,6 +16,7 @@
  *   along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <cassert>
 #include <thread>
 #include <mutex>
@@ -23,6 +24,8 @@
 
 #include "backend/cpu/Cpu.h"
 #include "backend/cpu/CpuWorker.h"
+#include "backend/common/Profile.h"
+#include "base/net/stratum/JobLatency.h"
 #include "base/tools/Alignment.h"
 #include "base/tools/Chrono.h"
 #include "core/config/Config.h"
@@ -52,7 +55,10 @@
 
 namespace xmrig {
 
-static constexpr uint32_t kReserveCount = 32768;
+static constexpr uint32_t kReserveCount     = 32768;
+static constexpr uint32_t kMinReserveCount  = 64;
+static constexpr uint32_t kMaxReserveCount  = 1U << 20;
+static constexpr uint64_t kLeaseTime        = 1000;
 
 
 #ifdef XMRIG_ALGO_CN_HEAVY
@@ -74,8 +80,12 @@ xmrig::CpuWorker<N>::CpuWorker(size_t id, const CpuLaunchData &data) :
     m_av(data.av()),
     m_miner(data.miner),
     m_threads(data.threads),
-    m_ctx()
+    m_ctx(),
+    m_reserveCount(kReserveCount),
+    m_leaseTs(Chrono::steadyMSecs())
 {
+    m_job.setNode(node());
+
 #   ifdef XMRIG_ALGO_CN_HEAVY
     // cn-heavy optimization for Zen3 CPUs
     const auto arch = Cpu::info()->arch();
@@ -100,14 +110,22 @@ xmrig::CpuWorker<N>::CpuWorker(size_t id, const CpuLaunchData &data) :
 #   ifdef XMRIG_ALGO_GHOSTRIDER
     m_ghHelper = ghostrider::create_helper_thread(affinity(), data.priority, data.affinities);
 #   endif
+
+    JobLatency::addWorker();
 }
 
 
 template<size_t N>
 xmrig::CpuWorker<N>::~CpuWorker()
 {
+    JobLatency::removeWorker();
+
 #   ifdef XMRIG_ALGO_RANDOMX
     RxVm::destroy(m_vm);
+
+    if (m_dataset) {
+        m_dataset->removeUser();
+    }
 #   endif
 
     CnCtx::release(m_ctx, N);
@@ -150,8 +168,36 @@ void xmrig::CpuWorker<N>::allocateRandomX_VM()
         // Update RandomX light VM with the new seed
         randomx_vm_set_cache(m_vm, dataset->cache()->get());
     }
+    else if (m_job.currentJob().seed() != m_seed) {
+        // Dataset may have been swapped with a precomputed one
+        randomx_vm_set_dataset(m_vm, dataset->get());
+    }
+
+    // Tells the storage this worker no longer reads the previous dataset, so precompute may reuse it
+    if (dataset != m_dataset) {
+        dataset->addUser();
+
+        if (m_dataset) {
+            m_dataset->removeUser();
+        }
+
+        m_dataset = dataset;
+    }
+
     m_seed = m_job.currentJob().seed();
 }
+
+
+template<size_t N>
+void xmrig::CpuWorker<N>::sign(const Job &job, const uint8_t *blob, uint8_t *out)
+{
+    if (m_signature.isValid()) {
+        m_signature.sign(blob, out);
+    }
+    else {
+        job.generateMinerSignature(blob, job.size(), out);
+    }
+}
 #endif
 
 
@@ -294,7 +340,7 @@ void xmrig::CpuWorker<N>::start()
                 if (first) {
                     first = false;
                     if (job.hasMinerSignature()) {
-                        job.generateMinerSignature(m_job.blob(), job.size(), miner_signature_ptr);
+                        sign(job, m_job.blob(), miner_signature_ptr);
                     }
                     randomx_calculate_hash_first(m_vm, tempHash, m_job.blob(), job.size());
                 }
@@ -303,9 +349,11 @@ void xmrig::CpuWorker<N>::start()
                     break;
                 }
 
+                ProfileSample sample(Profile::RANDOMX);
+
                 if (job.hasMinerSignature()) {
                     memcpy(miner_signature_saved, miner_signature_ptr, sizeof(miner_signature_saved));
-                    job.generateMinerSignature(m_job.blob(), job.size(), miner_signature_ptr);
+                    sign(job, m_job.blob(), miner_signature_ptr);
                 }
                 randomx_calculate_hash_next(m_vm, tempHash, m_job.blob(), job.size(), m_hash);
             }
@@ -317,6 +365,7 @@ void xmrig::CpuWorker<N>::start()
 #               ifdef XMRIG_ALGO_GHOSTRIDER
                 case Algorithm::GHOSTRIDER:
                     if (N == 8) {
+                        ProfileSample sample(Profile::GHOSTRIDER);
                         ghostrider::hash_octa(m_job.blob(), job.size(), m_hash, m_ctx, m_ghHelper);
                     }
                     else {
@@ -326,7 +375,10 @@ void xmrig::CpuWorker<N>::start()
 #               endif
 
                 default:
-                    fn(job.algorithm())(m_job.blob(), job.size(), m_hash, m_ctx, job.height());
+                    {
+                        ProfileSample sample(Profile::id(job.algorithm()));
+                        fn(job.algorithm())(m_job.blob(), job.size(), m_hash, m_ctx, job.height());
+                    }
                     break;
                 }
 
@@ -367,10 +419,14 @@ void xmrig::CpuWorker<N>::start()
 template<size_t N>
 bool xmrig::CpuWorker<N>::nextRound()
 {
+    if (m_job.isLeaseEnd(1)) {
+        updateLease(0);
+    }
+
 #   ifdef XMRIG_FEATURE_BENCHMARK
-    const uint32_t count = m_benchSize ? 1U : kReserveCount;
+    const uint32_t count = m_benchSize ? 1U : m_reserveCount;
 #   else
-    constexpr uint32_t count = kReserveCount;
+    const uint32_t count = m_reserveCount;
 #   endif
 
     if (!m_job.nextRound(count, 1)) {
@@ -503,26 +559,63 @@ void xmrig::CpuWorker<N>::consumeJob()
         return;
     }
 
-    auto job = m_miner->job();
+    ProfileSample sample(Profile::JOB_SWITCH);
+
+    auto job = m_miner->job(Nonce::CPU);
+
+    updateLease(kLeaseTime);
 
 #   ifdef XMRIG_FEATURE_BENCHMARK
-    m_benchSize          = job.benchSize();
-    const uint32_t count = m_benchSize ? 1U : kReserveCount;
+    m_benchSize          = job->benchSize();
+    const uint32_t count = m_benchSize ? 1U : m_reserveCount;
 #   else
-    constexpr uint32_t count = kReserveCount;
+    const uint32_t count = m_reserveCount;
 #   endif
 
-    m_job.add(job, count, Nonce::CPU);
+    const bool switched = m_job.add(job, count, Nonce::CPU);
 
 #   ifdef XMRIG_ALGO_RANDOMX
     if (m_job.currentJob().algorithm().family() == Algorithm::RANDOM_X) {
         allocateRandomX_VM();
+
+        const Job &current = m_job.currentJob();
+        if (current.hasMinerSignature()) {
+            m_signature.reset(m_job.blob(), current.size(), current.nonceOffset() + current.nonceSize(), current.ephPublicKey(), current.ephSecretKey());
+        }
     }
     else
 #   endif
     {
         allocateCnCtx();
     }
+
+    // Resumes after a pause and refills of the same job are not job switches
+    if (switched) {
+        JobLatency::consumed();
+    }
+}
+
+
+template<size_t N>
+void xmrig::CpuWorker<N>::updateLease(uint64_t minTime)
+{
+    // Size nonce leases from the measured hashrate, so each thread takes a new one about once per kLeaseTime on any algorithm.
+    const uint64_t ts      = Chrono::steadyMSecs();
+    const uint64_t elapsed = ts - m_leaseTs;
+    const uint64_t rounds  = (m_count - m_leaseCount) / N;
+
+    if (elapsed < minTime) {
+        return;
+    }
+
+    m_leaseTs    = ts;
+    m_leaseCount = m_count;
+
+    if (elapsed > 0 && rounds > 0) {
+        const uint64_t count = (m_reserveCount + rounds * kLeaseTime / elapsed) / 2;
+
+        m_reserveCount = static_cast<uint32_t>(std::min<uint64_t>(std::max<uint64_t>(count, kMinReserveCount), kMaxReserveCount));
+    }
 }
 
 
@@ -28,6 +28,8 @@
 
 
 #ifdef XMRIG_ALGO_RANDOMX
+#   include "base/tools/cryptonote/MinerSignature.h"
+
 class randomx_vm;
 #endif
 
@@ -35,6 +37,7 @@ class randomx_vm;
 namespace xmrig {
 
 
+class RxDataset;
 class RxVm;
 
 
@@ -75,6 +78,7 @@ private:
 
 #   ifdef XMRIG_ALGO_RANDOMX
     void allocateRandomX_VM();
+    void sign(const Job &job, const uint8_t *blob, uint8_t *out);
 #   endif
 
     bool nextRound();
@@ -82,6 +86,7 @@ private:
     bool verify2(const Algorithm &algorithm, const uint8_t *referenceValue);
     void allocateCnCtx();
     void consumeJob();
+    void updateLease(uint64_t minTime);
 
     alignas(8) uint8_t m_hash[N * 32]{ 0 };
     const Algorithm m_algorithm;
@@ -92,12 +97,17 @@ private:
     const Miner *m_miner;
     const size_t m_threads;
     cryptonight_ctx *m_ctx[N];
+    uint32_t m_reserveCount;
+    uint64_t m_leaseCount   = 0;
+    uint64_t m_leaseTs;
     VirtualMemory *m_memory = nullptr;
     WorkerJob<N> m_job;
 
 #   ifdef XMRIG_ALGO_RANDOMX
     randomx_vm *m_vm        = nullptr;
+    RxDataset *m_dataset    = nullptr;
     Buffer m_seed;
+    MinerSignature m_signature;
 #   endif
 
 #   ifdef XMRIG_ALGO_GHOSTRIDER
@@ -308,7 +308,7 @@ void xmrig::HwlocCpuInfo::processTopLevelCache(hwloc_obj_t cache, const Algorith
     int L2_associativity    = 0;
     size_t extra            = 0;
     size_t scratchpad       = algorithm.l3();
-    uint32_t intensity      = algorithm.maxIntensity() == 1 ? 0 : 1;
+    uint32_t intensity      = (algorithm.maxIntensity() == 1 || algorithm.family() == Algorithm::ARGON2) ? 0 : 1;
 
     if (cache->attr->cache.depth == 3) {
         for (size_t i = 0; i < cache->arity; ++i) {
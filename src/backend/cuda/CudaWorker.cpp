@@ -171,7 +171,7 @@ bool xmrig::CudaWorker::consumeJob()
         return false;
     }
 
-    m_job.add(m_miner->job(), intensity(), Nonce::CUDA);
+    m_job.add(m_miner->job(Nonce::CUDA), intensity(), Nonce::CUDA);
 
     return m_runner->set(m_job.currentJob(), m_job.blob());
 }
@@ -203,7 +203,7 @@ bool xmrig::OclWorker::consumeJob()
         return false;
     }
 
-    m_job.add(m_miner->job(), intensity(), Nonce::OPENCL);
+    m_job.add(m_miner->job(Nonce::OPENCL), intensity(), Nonce::OPENCL);
 
     try {
         m_runner->set(m_job.currentJob(), m_job.blob());
@@ -20,12 +20,16 @@
 
 
 #include "base/api/Api.h"
+#include "3rdparty/llhttp/llhttp.h"
 #include "base/api/interfaces/IApiListener.h"
+#include "base/api/Metrics.h"
 #include "base/api/requests/HttpApiRequest.h"
 #include "base/crypto/keccak.h"
 #include "base/io/Env.h"
 #include "base/io/json/Json.h"
 #include "base/kernel/Base.h"
+#include "base/net/http/HttpClientPool.h"
+#include "base/net/http/HttpData.h"
 #include "base/tools/Chrono.h"
 #include "base/tools/Cvt.h"
 #include "core/config/Config.h"
@@ -38,6 +42,7 @@
 #endif
 
 
+#include <cinttypes>
 #include <thread>
 
 
@@ -78,6 +83,36 @@ static rapidjson::Value getResources(rapidjson::Document &doc)
 } // namespace xmrig
 
 
+void xmrig::Api::getMetrics(Metrics &metrics) const
+{
+    size_t rss = 0;
+    uv_resident_set_memory(&rss);
+
+    metrics.family("xmrig_build", Metrics::kInfo, "Miner version and identity.");
+    metrics.add("xmrig_build_info", uint64_t(1), { { "version", APP_VERSION }, { "id", m_id }, { "worker_id", m_workerId.data() } });
+
+    metrics.family("xmrig_uptime_seconds", Metrics::kGauge, "Time since the miner was started.", "seconds");
+    metrics.add("xmrig_uptime_seconds", static_cast<double>(Chrono::currentMSecsSinceEpoch() - m_timestamp) / 1000.0);
+
+    metrics.family("process_resident_memory_bytes", Metrics::kGauge, "Resident set size.", "bytes");
+    metrics.add("process_resident_memory_bytes", static_cast<uint64_t>(rss));
+
+    metrics.family("xmrig_system_memory_bytes", Metrics::kGauge, "System memory.", "bytes");
+    metrics.add("xmrig_system_memory_bytes", uv_get_free_memory(), { { "state", "free" } });
+    metrics.add("xmrig_system_memory_bytes", uv_get_total_memory(), { { "state", "total" } });
+
+    metrics.family("xmrig_http_client_requests", Metrics::kCounter, "Outgoing HTTP requests by the connection they were sent on.");
+    metrics.add("xmrig_http_client_requests_total", HttpClientPool::connections(), { { "connection", "new" } });
+    metrics.add("xmrig_http_client_requests_total", HttpClientPool::reuses(), { { "connection", "reused" } });
+
+    metrics.family("xmrig_http_client_retries", Metrics::kCounter, "Requests sent again because a reused connection was closed by the server.");
+    metrics.add("xmrig_http_client_retries_total", HttpClientPool::retries());
+
+    metrics.family("xmrig_http_client_tls_resumed", Metrics::kCounter, "New TLS connections that resumed a previous session.");
+    metrics.add("xmrig_http_client_tls_resumed_total", HttpClientPool::resumptions());
+}
+
+
 xmrig::Api::Api(Base *base) :
     m_base(base),
     m_timestamp(Chrono::currentMSecsSinceEpoch())
@@ -100,7 +135,34 @@ void xmrig::Api::request(const HttpData &req)
 {
     HttpApiRequest request(req, m_base->config()->http().isRestricted());
 
+    // The summary is built at most once per tick, every request until the next tick gets the same serialized reply.
+    const int key = request.cacheKey();
+    if (key > 0) {
+        auto &summary = m_summary[key - 1];
+        if (summary.json) {
+            request.setETag(summary.etag);
+
+            return request.end(summary.json);
+        }
+
+        char etag[40];
+        snprintf(etag, sizeof(etag), "\"%" PRIx64 "-%" PRIx64 "\"", m_timestamp, ++m_sequence);
+
+        summary.etag = static_cast<const char *>(etag);
+        request.setETag(summary.etag);
+
+        exec(request);
+
+        summary.json = request.cached();
+
+        return;
+    }
+
     exec(request);
+
+    if (req.method != HTTP_GET) {
+        invalidate();
+    }
 }
 
 
@@ -125,8 +187,14 @@ void xmrig::Api::stop()
 
 void xmrig::Api::tick()
 {
+    invalidate();
+
 #   ifdef XMRIG_FEATURE_HTTP
-    if (m_httpd->isBound() || !m_base->config()->http().isEnabled()) {
+    if (m_httpd->isBound()) {
+        return m_httpd->tick();
+    }
+
+    if (!m_base->config()->http().isEnabled()) {
         return;
     }
 
@@ -147,6 +215,8 @@ void xmrig::Api::onConfigChanged(Config *config, Config *previousConfig)
     if (config->apiWorkerId() != previousConfig->apiWorkerId()) {
         genWorkerId(config->apiWorkerId());
     }
+
+    invalidate();
 }
 
 
@@ -190,6 +260,11 @@ void xmrig::Api::exec(IApiRequest &request)
 #       endif
         reply.AddMember("features", features, allocator);
     }
+    else if (request.type() == IApiRequest::REQ_METRICS) {
+        request.accept();
+
+        getMetrics(request.metrics());
+    }
 
     for (IApiListener *listener : m_listeners) {
         listener->onRequest(request);
@@ -203,6 +278,14 @@ void xmrig::Api::exec(IApiRequest &request)
 }
 
 
+void xmrig::Api::invalidate()
+{
+    for (auto &summary : m_summary) {
+        summary.json.reset();
+    }
+}
+
+
 void xmrig::Api::genId(const String &id)
 {
     memset(m_id, 0, sizeof(m_id));
@@ -20,6 +20,8 @@
 #define XMRIG_API_H
 
 
+#include <memory>
+#include <string>
 #include <vector>
 
 
@@ -35,6 +37,7 @@ class Httpd;
 class HttpData;
 class IApiListener;
 class IApiRequest;
+class Metrics;
 class String;
 
 
@@ -59,7 +62,15 @@ protected:
     void onConfigChanged(Config *config, Config *previousConfig) override;
 
 private:
+    struct Summary
+    {
+        std::shared_ptr<const std::string> json;
+        String etag;
+    };
+
     void exec(IApiRequest &request);
+    void invalidate();
+    void getMetrics(Metrics &metrics) const;
     void genId(const String &id);
     void genWorkerId(const String &id);
 
@@ -69,7 +80,9 @@ private:
     Httpd *m_httpd  = nullptr;
     std::vector<IApiListener *> m_listeners;
     String m_workerId;
-    uint8_t m_ticks = 0;
+    Summary m_summary[2];
+    uint64_t m_sequence = 0;
+    uint8_t m_ticks     = 0;
 };
 
 
@@ -21,6 +21,7 @@
 #include "base/api/Api.h"
 #include "base/io/log/Log.h"
 #include "base/net/http/HttpApiResponse.h"
+#include "base/net/http/HttpContext.h"
 #include "base/net/http/HttpData.h"
 #include "base/net/tools/TcpServer.h"
 #include "core/config/Config.h"
@@ -122,6 +123,12 @@ void xmrig::Httpd::stop()
 
 
 
+void xmrig::Httpd::tick()
+{
+    HttpContext::closeIdle();
+}
+
+
 void xmrig::Httpd::onConfigChanged(Config *config, Config *previousConfig)
 {
     if (config->http() == previousConfig->http()) {
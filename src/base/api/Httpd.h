@@ -45,6 +45,7 @@ public:
 
     bool start();
     void stop();
+    void tick();
 
 protected:
     void onConfigChanged(Config *config, Config *previousConfig) override;
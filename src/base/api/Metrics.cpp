@@ -0,0 +1,146 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "base/api/Metrics.h"
+
+
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+
+
+namespace xmrig {
+
+
+const char *Metrics::kContentType   = "application/openmetrics-text; version=1.0.0; charset=utf-8";
+const char *Metrics::kCounter       = "counter";
+const char *Metrics::kGauge         = "gauge";
+const char *Metrics::kHistogram     = "histogram";
+const char *Metrics::kInfo          = "info";
+const char *Metrics::kSummary       = "summary";
+
+
+} // namespace xmrig
+
+
+xmrig::Metrics::Metrics()
+{
+    m_data.reserve(16384);
+}
+
+
+void xmrig::Metrics::add(const char *name, double value, Labels labels)
+{
+    m_data += name;
+    this->labels(labels);
+
+    if (std::isnan(value)) {
+        m_data += " NaN\n";
+    }
+    else if (std::isinf(value)) {
+        m_data += value > 0 ? " +Inf\n" : " -Inf\n";
+    }
+    else {
+        char buf[32];
+        snprintf(buf, sizeof(buf), " %.10g\n", value);
+        m_data += buf;
+    }
+}
+
+
+void xmrig::Metrics::add(const char *name, uint64_t value, Labels labels)
+{
+    char buf[24];
+    snprintf(buf, sizeof(buf), " %" PRIu64 "\n", value);
+
+    m_data += name;
+    this->labels(labels);
+    m_data += buf;
+}
+
+
+void xmrig::Metrics::end()
+{
+    m_data += "# EOF\n";
+}
+
+
+void xmrig::Metrics::family(const char *name, const char *type, const char *help, const char *unit)
+{
+    m_data += "# TYPE ";
+    m_data += name;
+    m_data += ' ';
+    m_data += type;
+    m_data += '\n';
+
+    if (unit) {
+        m_data += "# UNIT ";
+        m_data += name;
+        m_data += ' ';
+        m_data += unit;
+        m_data += '\n';
+    }
+
+    m_data += "# HELP ";
+    m_data += name;
+    m_data += ' ';
+    m_data += help;
+    m_data += '\n';
+}
+
+
+void xmrig::Metrics::labels(Labels labels)
+{
+    if (labels.size() == 0) {
+        return;
+    }
+
+    char separator = '{';
+
+    for (const auto &label : labels) {
+        m_data += separator;
+        m_data += label.first;
+        m_data += "=\"";
+
+        for (const char *c = label.second; c && *c; ++c) {
+            switch (*c) {
+            case '\\':
+                m_data += "\\\\";
+                break;
+
+            case '"':
+                m_data += "\\\"";
+                break;
+
+            case '\n':
+                m_data += "\\n";
+                break;
+
+            default:
+                m_data += *c;
+                break;
+            }
+        }
+
+        m_data += '"';
+        separator = ',';
+    }
+
+    m_data += '}';
+}
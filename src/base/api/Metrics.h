@@ -0,0 +1,71 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef XMRIG_METRICS_H
+#define XMRIG_METRICS_H
+
+
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <utility>
+
+
+#include "base/tools/Object.h"
+
+
+namespace xmrig {
+
+
+// OpenMetrics text exposition, samples are appended straight into one preallocated buffer (no DOM).
+class Metrics
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE(Metrics)
+
+    using Label  = std::pair<const char *, const char *>;
+    using Labels = std::initializer_list<Label>;
+
+    static const char *kContentType;
+    static const char *kCounter;
+    static const char *kGauge;
+    static const char *kHistogram;
+    static const char *kInfo;
+    static const char *kSummary;
+
+    Metrics();
+
+    inline const std::string &data() const  { return m_data; }
+
+    void add(const char *name, double value, Labels labels = {});
+    void add(const char *name, uint64_t value, Labels labels = {});
+    void end();
+    void family(const char *name, const char *type, const char *help, const char *unit = nullptr);
+
+private:
+    void labels(Labels labels);
+
+    std::string m_data;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_METRICS_H */
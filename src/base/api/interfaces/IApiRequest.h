@@ -27,6 +27,7 @@
 namespace xmrig {
 
 
+class Metrics;
 class String;
 
 
@@ -52,7 +53,8 @@ public:
     enum RequestType {
         REQ_UNKNOWN,
         REQ_SUMMARY,
-        REQ_JSON_RPC
+        REQ_JSON_RPC,
+        REQ_METRICS
     };
 
 
@@ -76,6 +78,7 @@ public:
     virtual const String &rpcMethod() const                             = 0;
     virtual const String &url() const                                   = 0;
     virtual int version() const                                         = 0;
+    virtual Metrics &metrics()                                          = 0;
     virtual Method method() const                                       = 0;
     virtual rapidjson::Document &doc()                                  = 0;
     virtual rapidjson::Value &reply()                                   = 0;
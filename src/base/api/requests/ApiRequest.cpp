@@ -34,3 +34,14 @@ xmrig::ApiRequest::ApiRequest(Source source, bool restricted) :
 
 
 xmrig::ApiRequest::~ApiRequest() = default;
+
+
+// Only REQ_METRICS requests fill the buffer, so it is allocated on first use
+xmrig::Metrics &xmrig::ApiRequest::metrics()
+{
+    if (!m_metrics) {
+        m_metrics.reset(new Metrics());
+    }
+
+    return *m_metrics;
+}
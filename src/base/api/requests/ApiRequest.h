@@ -28,10 +28,14 @@
 
 
 #include "base/api/interfaces/IApiRequest.h"
+#include "base/api/Metrics.h"
 #include "base/tools/String.h"
 #include "base/tools/Object.h"
 
 
+#include <memory>
+
+
 namespace xmrig {
 
 
@@ -60,10 +64,13 @@ protected:
     inline Source source() const override           { return m_source; }
     inline void done(int) override                  { m_state = STATE_DONE; }
 
+    Metrics &metrics() override;
+
     int m_version       = 1;
     RequestType m_type  = REQ_UNKNOWN;
     State m_state       = STATE_NEW;
     String m_rpcMethod;
+    std::unique_ptr<Metrics> m_metrics;
 
 private:
     const bool m_restricted;
@@ -27,9 +27,10 @@
 namespace xmrig {
 
 
-static const char *kError  = "error";
-static const char *kId     = "id";
-static const char *kResult = "result";
+static const char *kError       = "error";
+static const char *kId          = "id";
+static const char *kIfNoneMatch = "if-none-match";
+static const char *kResult      = "result";
 
 
 static inline const char *rpcError(int code) {
@@ -71,6 +72,9 @@ xmrig::HttpApiRequest::HttpApiRequest(const HttpData &req, bool restricted) :
         if (url() == "/1/summary" || url() == "/2/summary" || url() == "/api.json") {
             m_type = REQ_SUMMARY;
         }
+        else if (url() == "/metrics") {
+            m_type = REQ_METRICS;
+        }
     }
 
     if (method() == METHOD_POST && url() == "/json_rpc") {
@@ -103,6 +107,24 @@ xmrig::HttpApiRequest::HttpApiRequest(const HttpData &req, bool restricted) :
 }
 
 
+void xmrig::HttpApiRequest::end(const std::shared_ptr<const std::string> &json)
+{
+    ApiRequest::done(200);
+
+    m_res.setHeader("ETag", m_etag.data());
+    m_res.setHeader("Cache-Control", "no-cache");
+
+    if (m_req.headers.count(kIfNoneMatch) && m_req.headers.at(kIfNoneMatch).find(m_etag.data()) != std::string::npos) {
+        m_res.setStatus(304 /* NOT_MODIFIED */);
+
+        return m_res.end(std::string());
+    }
+
+    m_res.setStatus(200);
+    m_res.end(*json);
+}
+
+
 bool xmrig::HttpApiRequest::accept()
 {
     using namespace rapidjson;
@@ -164,6 +186,19 @@ void xmrig::HttpApiRequest::done(int status)
             setRpcResult(result);
         }
     }
+    else if (type() == REQ_SUMMARY && status == 200 && !m_etag.isNull()) {
+        m_cached = m_res.serialize();
+
+        return end(m_cached);
+    }
+    else if (type() == REQ_METRICS && status == 200) {
+        metrics().end();
+
+        m_res.setStatus(status);
+        m_res.setHeader(HttpData::kContentType, Metrics::kContentType);
+
+        return m_res.HttpResponse::end(metrics().data().data(), metrics().data().size());
+    }
     else {
         m_res.setStatus(status);
     }
@@ -37,6 +37,12 @@ class HttpApiRequest : public ApiRequest
 public:
     HttpApiRequest(const HttpData &req, bool restricted);
 
+    inline const std::shared_ptr<const std::string> &cached() const    { return m_cached; }
+    inline int cacheKey() const                                         { return m_type == REQ_SUMMARY ? m_version : 0; }
+    inline void setETag(const String &etag)                             { m_etag = etag; }
+
+    void end(const std::shared_ptr<const std::string> &json);
+
 protected:
     inline bool hasParseError() const override           { return m_parsed == 2; }
     inline const String &url() const override            { return m_url; }
@@ -57,6 +63,8 @@ private:
     HttpApiResponse m_res;
     int m_parsed = 0;
     rapidjson::Document m_body;
+    std::shared_ptr<const std::string> m_cached;
+    String m_etag;
     String m_url;
 };
 
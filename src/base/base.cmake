@@ -54,6 +54,7 @@ set(HEADERS_BASE
     src/base/net/stratum/BaseClient.h
     src/base/net/stratum/Client.h
     src/base/net/stratum/Job.h
+    src/base/net/stratum/JobLatency.h
     src/base/net/stratum/NetworkState.h
     src/base/net/stratum/Pool.h
     src/base/net/stratum/Pools.h
@@ -77,6 +78,7 @@ set(HEADERS_BASE
     src/base/tools/cryptonote/BlobReader.h
     src/base/tools/cryptonote/BlockTemplate.h
     src/base/tools/cryptonote/crypto-ops.h
+    src/base/tools/cryptonote/MinerSignature.h
     src/base/tools/cryptonote/Signatures.h
     src/base/tools/cryptonote/umul128.h
     src/base/tools/cryptonote/WalletAddress.h
@@ -122,6 +124,7 @@ set(SOURCES_BASE
     src/base/net/stratum/BaseClient.cpp
     src/base/net/stratum/Client.cpp
     src/base/net/stratum/Job.cpp
+    src/base/net/stratum/JobLatency.cpp
     src/base/net/stratum/NetworkState.cpp
     src/base/net/stratum/Pool.cpp
     src/base/net/stratum/Pools.cpp
@@ -137,6 +140,7 @@ set(SOURCES_BASE
     src/base/tools/cryptonote/BlockTemplate.cpp
     src/base/tools/cryptonote/crypto-ops-data.c
     src/base/tools/cryptonote/crypto-ops.c
+    src/base/tools/cryptonote/MinerSignature.cpp
     src/base/tools/cryptonote/Signatures.cpp
     src/base/tools/cryptonote/WalletAddress.cpp
     src/base/tools/Cvt.cpp
@@ -187,6 +191,7 @@ if (WITH_HTTP)
         src/3rdparty/llhttp/llhttp.h
         src/base/api/Api.h
         src/base/api/Httpd.h
+        src/base/api/Metrics.h
         src/base/api/interfaces/IApiRequest.h
         src/base/api/requests/ApiRequest.h
         src/base/api/requests/HttpApiRequest.h
@@ -196,6 +201,7 @@ if (WITH_HTTP)
         src/base/net/http/Fetch.h
         src/base/net/http/HttpApiResponse.h
         src/base/net/http/HttpClient.h
+        src/base/net/http/HttpClientPool.h
         src/base/net/http/HttpContext.h
         src/base/net/http/HttpData.h
         src/base/net/http/HttpResponse.h
@@ -210,11 +216,13 @@ if (WITH_HTTP)
         src/3rdparty/llhttp/http.c
         src/base/api/Api.cpp
         src/base/api/Httpd.cpp
+        src/base/api/Metrics.cpp
         src/base/api/requests/ApiRequest.cpp
         src/base/api/requests/HttpApiRequest.cpp
         src/base/net/http/Fetch.cpp
         src/base/net/http/HttpApiResponse.cpp
         src/base/net/http/HttpClient.cpp
+        src/base/net/http/HttpClientPool.cpp
         src/base/net/http/HttpContext.cpp
         src/base/net/http/HttpData.cpp
         src/base/net/http/HttpListener.cpp
@@ -259,6 +267,23 @@ if (WITH_KAWPOW OR WITH_GHOSTRIDER)
 endif()
 
 
+if (WITH_EMULATOR AND WITH_HTTP)
+    add_definitions(/DXMRIG_FEATURE_EMULATOR)
+
+    list(APPEND HEADERS_BASE
+        src/base/net/stratum/emulator/Emulator.h
+        src/base/net/stratum/emulator/EmulatorConfig.h
+        )
+
+    list(APPEND SOURCES_BASE
+        src/base/net/stratum/emulator/Emulator.cpp
+        src/base/net/stratum/emulator/EmulatorConfig.cpp
+        )
+else()
+    remove_definitions(/DXMRIG_FEATURE_EMULATOR)
+endif()
+
+
 if (WITH_RANDOMX AND WITH_BENCHMARK)
     add_definitions(/DXMRIG_FEATURE_BENCHMARK)
 
@@ -21,86 +21,320 @@
 #include "base/io/Env.h"
 
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
 #include <uv.h>
 
 
 namespace xmrig {
 
 
-static void fsWriteCallback(uv_fs_t *req)
+// Lines are copied into a preallocated ring and written to disk by a single flush thread in batches,
+// logging threads never allocate memory or wait for the file system.
+static constexpr size_t kRingSize       = 1024 * 1024;
+static constexpr size_t kFlushWatermark = kRingSize / 8;
+static constexpr auto kFlushInterval    = std::chrono::milliseconds(100);
+
+
+#ifdef XMRIG_OS_WIN
+static const char kEndl[] = "\r\n";
+#else
+static const char kEndl[] = "\n";
+#endif
+
+
+class FileLogWriterPrivate
 {
-    delete [] static_cast<char *>(req->data);
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(FileLogWriterPrivate)
 
-    uv_fs_req_cleanup(req);
-    delete req;
-}
+    inline FileLogWriterPrivate(std::string &&path, int file, int64_t pos, uint64_t maxSize) :
+        m_path(std::move(path)),
+        m_maxSize(maxSize),
+        m_file(file),
+        m_ring(new char[kRingSize]),
+        m_pos(pos)
+    {
+        m_thread = std::thread(&FileLogWriterPrivate::run, this);
+    }
 
 
-} // namespace xmrig
+    inline ~FileLogWriterPrivate()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
 
+        m_cv.notify_one();
+        m_thread.join();
 
-bool xmrig::FileLogWriter::open(const char *fileName)
-{
-    assert(fileName != nullptr);
-    if (!fileName) {
-        return false;
+        close(m_file);
+        delete [] m_ring;
     }
 
-    uv_fs_t req{};
-    const auto path = Env::expand(fileName);
-    m_file          = uv_fs_open(uv_default_loop(), &req, path, O_CREAT | O_WRONLY, 0644, nullptr);
 
-    if (req.result < 0 || !isOpen()) {
+    static int open(const char *path, int flags, int64_t *pos)
+    {
+        uv_fs_t req{};
+        const int file = uv_fs_open(uv_default_loop(), &req, path, flags, 0644, nullptr);
         uv_fs_req_cleanup(&req);
-        m_file = -1;
 
-        return false;
+        if (file < 0) {
+            return -1;
+        }
+
+        uv_fs_stat(uv_default_loop(), &req, path, nullptr);
+        *pos = req.result == 0 ? static_cast<int64_t>(req.statbuf.st_size) : 0;
+        uv_fs_req_cleanup(&req);
+
+        return file;
     }
 
-    uv_fs_req_cleanup(&req);
 
-    uv_fs_stat(uv_default_loop(), &req, path, nullptr);
-    m_pos = req.statbuf.st_size;
-    uv_fs_req_cleanup(&req);
+    static void close(int file)
+    {
+        if (file < 0) {
+            return;
+        }
 
-    return true;
+        uv_fs_t req{};
+        uv_fs_close(uv_default_loop(), &req, file, nullptr);
+        uv_fs_req_cleanup(&req);
+    }
+
+
+    bool push(const char *data, size_t size, const char *tail, size_t tailSize)
+    {
+        const size_t total = size + tailSize;
+        uint64_t head      = m_reserved.load(std::memory_order_relaxed);
+
+        do {
+            if (head + total - m_flushed.load(std::memory_order_acquire) > kRingSize) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+
+                return false;
+            }
+        } while (!m_reserved.compare_exchange_weak(head, head + total, std::memory_order_relaxed));
+
+        copy(head, data, size);
+        copy(head + size, tail, tailSize);
+
+        // Publish in reservation order, Log already serializes backends so this normally never spins.
+        while (m_committed.load(std::memory_order_acquire) != head) {
+            std::this_thread::yield();
+        }
+
+        m_committed.store(head + total, std::memory_order_release);
+
+        const uint64_t pending = head + total - m_flushed.load(std::memory_order_relaxed);
+        if (pending >= kFlushWatermark && pending - total < kFlushWatermark) {
+            m_cv.notify_one();
+        }
+
+        return true;
+    }
+
+
+    inline int64_t pos() const      { return m_pos.load(std::memory_order_relaxed); }
+    inline uint64_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+    inline uint64_t pending() const { return m_committed.load(std::memory_order_relaxed) - m_flushed.load(std::memory_order_relaxed); }
+
+
+    void copy(uint64_t pos, const char *data, size_t size)
+    {
+        if (size == 0) {
+            return;
+        }
+
+        const size_t offset = pos & (kRingSize - 1);
+        const size_t first  = std::min(size, kRingSize - offset);
+
+        memcpy(m_ring + offset, data, first);
+        memcpy(m_ring, data + first, size - first);
+    }
+
+
+    void flush()
+    {
+        const uint64_t begin = m_flushed.load(std::memory_order_relaxed);
+        const uint64_t end   = m_committed.load(std::memory_order_acquire);
+
+        if (end != begin) {
+            const size_t size   = end - begin;
+            const size_t offset = begin & (kRingSize - 1);
+            const size_t first  = std::min(size, kRingSize - offset);
+
+            uv_buf_t bufs[2] = {
+                uv_buf_init(m_ring + offset, static_cast<unsigned int>(first)),
+                uv_buf_init(m_ring, static_cast<unsigned int>(size - first))
+            };
+
+            write(bufs, size > first ? 2 : 1);
+            m_flushed.store(end, std::memory_order_release);
+        }
+
+        const uint64_t dropped = m_dropped.load(std::memory_order_relaxed);
+        if (dropped != m_reported) {
+            char buf[96];
+            const int size = snprintf(buf, sizeof(buf), "[log] %llu messages dropped, log file is too slow%s", static_cast<unsigned long long>(dropped - m_reported), kEndl);
+
+            uv_buf_t note = uv_buf_init(buf, static_cast<unsigned int>(size));
+            write(&note, 1);
+            m_reported = dropped;
+        }
+
+        if (m_maxSize && pos() >= static_cast<int64_t>(m_maxSize)) {
+            rotate();
+        }
+    }
+
+
+    void rotate()
+    {
+        close(m_file);
+
+        const std::string rotated = m_path + ".1";
+
+        uv_fs_t req{};
+        uv_fs_rename(uv_default_loop(), &req, m_path.c_str(), rotated.c_str(), nullptr);
+        uv_fs_req_cleanup(&req);
+
+        int64_t pos = 0;
+        m_file      = open(m_path.c_str(), O_CREAT | O_WRONLY | O_TRUNC, &pos);
+        m_pos       = pos;
+    }
+
+
+    void run()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        while (true) {
+            m_cv.wait_for(lock, kFlushInterval, [this] { return m_stop || pending() >= kFlushWatermark; });
+
+            const bool stop = m_stop;
+            lock.unlock();
+
+            flush();
+
+            if (stop) {
+                break;
+            }
+
+            lock.lock();
+        }
+    }
+
+
+    void write(uv_buf_t *bufs, size_t nbufs)
+    {
+        size_t i = 0;
+
+        while (i < nbufs && m_file >= 0) {
+            uv_fs_t req{};
+            const int rc = uv_fs_write(uv_default_loop(), &req, m_file, bufs + i, static_cast<unsigned int>(nbufs - i), pos(), nullptr);
+            uv_fs_req_cleanup(&req);
+
+            if (rc <= 0) {
+                return;
+            }
+
+            m_pos += rc;
+
+            auto n = static_cast<size_t>(rc);
+            while (i < nbufs && n >= bufs[i].len) {
+                n -= bufs[i].len;
+                ++i;
+            }
+
+            if (i < nbufs) {
+                bufs[i].base += n;
+                bufs[i].len  -= n;
+            }
+        }
+    }
+
+
+    bool m_stop         = false;
+    const std::string m_path;
+    const uint64_t m_maxSize;
+    int m_file;
+    char *m_ring;
+    std::atomic<int64_t> m_pos;
+    std::atomic<uint64_t> m_committed{0};
+    std::atomic<uint64_t> m_dropped{0};
+    std::atomic<uint64_t> m_flushed{0};
+    std::atomic<uint64_t> m_reserved{0};
+    std::condition_variable m_cv;
+    std::mutex m_mutex;
+    std::thread m_thread;
+    uint64_t m_reported = 0;
+};
+
+
+} // namespace xmrig
+
+
+xmrig::FileLogWriter::~FileLogWriter()
+{
+    delete d_ptr;
 }
 
 
-bool xmrig::FileLogWriter::write(const char *data, size_t size)
+bool xmrig::FileLogWriter::open(const char *fileName, uint64_t maxSize)
 {
-    if (!isOpen()) {
+    assert(fileName != nullptr);
+    if (!fileName) {
         return false;
     }
 
-    uv_buf_t buf = uv_buf_init(new char[size], size);
-    memcpy(buf.base, data, size);
+    delete d_ptr;
+    d_ptr = nullptr;
 
-    auto req = new uv_fs_t;
-    req->data = buf.base;
+    std::string path = Env::expand(fileName).data();
+    int64_t pos      = 0;
+    const int file   = FileLogWriterPrivate::open(path.c_str(), O_CREAT | O_WRONLY, &pos);
 
-    uv_fs_write(uv_default_loop(), req, m_file, &buf, 1, m_pos, fsWriteCallback);
-    m_pos += size;
+    if (file < 0) {
+        return false;
+    }
+
+    d_ptr = new FileLogWriterPrivate(std::move(path), file, pos, maxSize);
 
     return true;
 }
 
 
+bool xmrig::FileLogWriter::write(const char *data, size_t size)
+{
+    return isOpen() && d_ptr->push(data, size, nullptr, 0);
+}
+
+
 bool xmrig::FileLogWriter::writeLine(const char *data, size_t size)
 {
-    const uv_buf_t buf[2] = {
-        uv_buf_init(new char[size], size),
-        uv_buf_init(const_cast<char *>(m_endl), sizeof(m_endl) - 1)
-    };
+    return isOpen() && d_ptr->push(data, size, kEndl, sizeof(kEndl) - 1);
+}
 
-    memcpy(buf[0].base, data, size);
 
-    auto req = new uv_fs_t;
-    req->data = buf[0].base;
+int64_t xmrig::FileLogWriter::pos() const
+{
+    return isOpen() ? d_ptr->pos() : 0;
+}
 
-    uv_fs_write(uv_default_loop(), req, m_file, buf, 2, m_pos, fsWriteCallback);
-    m_pos += (buf[0].len + buf[1].len);
 
-    return true;
+uint64_t xmrig::FileLogWriter::dropped() const
+{
+    return isOpen() ? d_ptr->dropped() : 0;
 }
@@ -20,6 +20,9 @@
 #define XMRIG_FILELOGWRITER_H
 
 
+#include "base/tools/Object.h"
+
+
 #include <cstddef>
 #include <cstdint>
 
@@ -27,28 +30,28 @@
 namespace xmrig {
 
 
+class FileLogWriterPrivate;
+
+
 class FileLogWriter
 {
 public:
+    XMRIG_DISABLE_COPY_MOVE(FileLogWriter)
+
     FileLogWriter() = default;
-    FileLogWriter(const char *fileName) { open(fileName); }
+    FileLogWriter(const char *fileName, uint64_t maxSize = 0) { open(fileName, maxSize); }
+    ~FileLogWriter();
 
-    inline bool isOpen() const  { return m_file >= 0; }
-    inline int64_t pos() const  { return m_pos; }
+    inline bool isOpen() const  { return d_ptr != nullptr; }
 
-    bool open(const char *fileName);
+    bool open(const char *fileName, uint64_t maxSize = 0);
     bool write(const char *data, size_t size);
     bool writeLine(const char *data, size_t size);
+    int64_t pos() const;
+    uint64_t dropped() const;
 
 private:
-#   ifdef XMRIG_OS_WIN
-    const char m_endl[3]  = {'\r', '\n', 0};
-#   else
-    const char m_endl[2]  = {'\n', 0};
-#   endif
-
-    int m_file      = -1;
-    int64_t m_pos   = 0;
+    FileLogWriterPrivate *d_ptr = nullptr;
 };
 
 
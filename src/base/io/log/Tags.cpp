@@ -70,6 +70,14 @@ const char *xmrig::Tags::miner()
 }
 
 
+const char *xmrig::Tags::profiler()
+{
+    static const char *tag = CYAN_BG_BOLD(WHITE_BOLD_S " profile ");
+
+    return tag;
+}
+
+
 #ifdef XMRIG_ALGO_RANDOMX
 const char *xmrig::Tags::randomx()
 {
@@ -121,10 +129,10 @@ const char *xmrig::Tags::opencl()
 #endif
 
 
-#ifdef XMRIG_FEATURE_PROFILING
-const char* xmrig::Tags::profiler()
+#ifdef XMRIG_FEATURE_EMULATOR
+const char *xmrig::Tags::emulator()
 {
-    static const char* tag = CYAN_BG_BOLD(WHITE_BOLD_S " profile ");
+    static const char *tag = YELLOW_BG_BOLD(WHITE_BOLD_S " emulator");
 
     return tag;
 }
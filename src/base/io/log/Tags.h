@@ -38,6 +38,7 @@ public:
 #   ifdef XMRIG_MINER_PROJECT
     static const char *cpu();
     static const char *miner();
+    static const char *profiler();
 #   ifdef XMRIG_ALGO_RANDOMX
     static const char *randomx();
 #   endif
@@ -58,8 +59,8 @@ public:
     static const char *opencl();
 #   endif
 
-#   ifdef XMRIG_FEATURE_PROFILING
-    static const char* profiler();
+#   ifdef XMRIG_FEATURE_EMULATOR
+    static const char *emulator();
 #   endif
 };
 
@@ -31,7 +31,7 @@ namespace xmrig {
 class FileLog : public ILogBackend
 {
 public:
-    FileLog(const char *fileName);
+    FileLog(const char *fileName, uint64_t maxSize = 0);
 
 protected:
     void print(uint64_t timestamp, int level, const char *line, size_t offset, size_t size, bool colors) override;
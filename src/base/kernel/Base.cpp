@@ -55,6 +55,11 @@ static const char *kConfigPathV2 = "/2/config";
 #endif
 
 
+#ifdef XMRIG_FEATURE_EMULATOR
+#   include "base/net/stratum/emulator/Emulator.h"
+#endif
+
+
 #ifdef XMRIG_FEATURE_EMBEDDED_CONFIG
 #   include "core/config/Config_default.h"
 #endif
@@ -113,6 +118,9 @@ public:
 
     Api *api            = nullptr;
     Config *config      = nullptr;
+#   ifdef XMRIG_FEATURE_EMULATOR
+    Emulator *emulator  = nullptr;
+#   endif
     std::vector<IBaseListener *> listeners;
     Watcher *watcher    = nullptr;
 
@@ -197,7 +205,7 @@ int xmrig::Base::init()
     }
 
     if (config()->logFile()) {
-        Log::add(new FileLog(config()->logFile()));
+        Log::add(new FileLog(config()->logFile(), static_cast<uint64_t>(config()->logFileSize()) * 1024 * 1024));
     }
 
 #   ifdef HAVE_SYSLOG_H
@@ -216,6 +224,13 @@ void xmrig::Base::start()
     api()->start();
 #   endif
 
+#   ifdef XMRIG_FEATURE_EMULATOR
+    if (config()->emulator().isEnabled()) {
+        d_ptr->emulator = new Emulator(config()->emulator());
+        d_ptr->emulator->start();
+    }
+#   endif
+
     if (config()->isShouldSave()) {
         config()->save();
     }
@@ -232,6 +247,11 @@ void xmrig::Base::stop()
     api()->stop();
 #   endif
 
+#   ifdef XMRIG_FEATURE_EMULATOR
+    delete d_ptr->emulator;
+    d_ptr->emulator = nullptr;
+#   endif
+
     delete d_ptr->watcher;
     d_ptr->watcher = nullptr;
 }
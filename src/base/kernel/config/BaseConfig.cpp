@@ -24,6 +24,8 @@
 #include "base/io/log/Tags.h"
 #include "base/kernel/interfaces/IJsonReader.h"
 #include "base/net/dns/Dns.h"
+#include "base/net/stratum/Client.h"
+#include "base/net/tools/LineReader.h"
 #include "version.h"
 
 
@@ -56,6 +58,7 @@ const char *BaseConfig::kColors         = "colors";
 const char *BaseConfig::kDryRun         = "dry-run";
 const char *BaseConfig::kHttp           = "http";
 const char *BaseConfig::kLogFile        = "log-file";
+const char *BaseConfig::kLogFileSize    = "log-file-size";
 const char *BaseConfig::kPrintTime      = "print-time";
 const char *BaseConfig::kSyslog         = "syslog";
 const char *BaseConfig::kTitle          = "title";
@@ -86,6 +89,7 @@ bool xmrig::BaseConfig::read(const IJsonReader &reader, const char *fileName)
     m_syslog            = reader.getBool(kSyslog, m_syslog);
     m_watch             = reader.getBool(kWatch, m_watch);
     m_logFile           = reader.getString(kLogFile);
+    m_logFileSize       = reader.getUint(kLogFileSize, m_logFileSize);
     m_userAgent         = reader.getString(kUserAgent);
     m_printTime         = std::min(reader.getUint(kPrintTime, m_printTime), 3600U);
     m_title             = reader.getValue(kTitle);
@@ -106,6 +110,13 @@ bool xmrig::BaseConfig::read(const IJsonReader &reader, const char *fileName)
     m_http.load(reader.getObject(kHttp));
     m_pools.load(reader);
 
+#   ifdef XMRIG_FEATURE_EMULATOR
+    m_emulator.load(reader.getObject(EmulatorConfig::kField));
+#   endif
+
+    LineReader::setMaxSize(m_pools.maxLineSize());
+    Client::setSubmitPolicy(m_pools.submitWindow(), m_pools.submitInflight());
+
     Dns::set(reader.getObject(DnsConfig::kField));
 
     return m_pools.active() > 0;
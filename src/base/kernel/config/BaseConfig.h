@@ -31,6 +31,11 @@
 #endif
 
 
+#ifdef XMRIG_FEATURE_EMULATOR
+#   include "base/net/stratum/emulator/EmulatorConfig.h"
+#endif
+
+
 namespace xmrig {
 
 
@@ -49,6 +54,7 @@ public:
     static const char *kDryRun;
     static const char *kHttp;
     static const char *kLogFile;
+    static const char *kLogFileSize;
     static const char *kPrintTime;
     static const char *kSyslog;
     static const char *kTitle;
@@ -67,6 +73,7 @@ public:
     inline bool isDryRun() const                            { return m_dryRun; }
     inline bool isSyslog() const                            { return m_syslog; }
     inline const char *logFile() const                      { return m_logFile.data(); }
+    inline uint32_t logFileSize() const                     { return m_logFileSize; }
     inline const char *userAgent() const                    { return m_userAgent.data(); }
     inline const Http &http() const                         { return m_http; }
     inline const Pools &pools() const                       { return m_pools; }
@@ -79,6 +86,10 @@ public:
     inline const TlsConfig &tls() const                     { return m_tls; }
 #   endif
 
+#   ifdef XMRIG_FEATURE_EMULATOR
+    inline const EmulatorConfig &emulator() const          { return m_emulator; }
+#   endif
+
     inline bool isWatch() const override                    { return m_watch && !m_fileName.isNull(); }
     inline const String &fileName() const override          { return m_fileName; }
     inline void setFileName(const char *fileName) override  { m_fileName = fileName; }
@@ -103,12 +114,17 @@ protected:
     String m_logFile;
     String m_userAgent;
     Title m_title;
+    uint32_t m_logFileSize  = 0;
     uint32_t m_printTime    = 60;
 
 #   ifdef XMRIG_FEATURE_TLS
     TlsConfig m_tls;
 #   endif
 
+#   ifdef XMRIG_FEATURE_EMULATOR
+    EmulatorConfig m_emulator;
+#   endif
+
 private:
     static void setVerbose(const rapidjson::Value &value);
 };
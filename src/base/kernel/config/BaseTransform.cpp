@@ -243,6 +243,13 @@ void xmrig::BaseTransform::transform(rapidjson::Document &doc, int key, const ch
 
     case IConfig::RetriesKey:       /* --retries */
     case IConfig::RetryPauseKey:    /* --retry-pause */
+    case IConfig::MaxLineSizeKey:   /* --max-line-size */
+    case IConfig::SubmitWindowKey:  /* --submit-window */
+    case IConfig::SubmitInflightKey: /* --submit-inflight */
+    case IConfig::LogFileSizeKey:   /* --log-file-size */
+    case IConfig::SwitchLatencyKey: /* --switch-latency */
+    case IConfig::SwitchRejectRateKey: /* --switch-reject-rate */
+    case IConfig::SwitchJobTimeoutKey: /* --switch-job-timeout */
     case IConfig::PrintTimeKey:     /* --print-time */
     case IConfig::HttpPort:         /* --http-port */
     case IConfig::DonateLevelKey:   /* --donate-level */
@@ -263,6 +270,7 @@ void xmrig::BaseTransform::transform(rapidjson::Document &doc, int key, const ch
     case IConfig::SubmitToOriginKey: /* --submit-to-origin */
     case IConfig::VerboseKey:     /* --verbose */
     case IConfig::DnsIPv6Key:     /* --dns-ipv6 */
+    case IConfig::HotStandbyKey:  /* --hot-standby */
         return transformBoolean(doc, key, true);
 
     case IConfig::ColorKey:          /* --no-color */
@@ -326,6 +334,9 @@ void xmrig::BaseTransform::transformBoolean(rapidjson::Document &doc, int key, b
     case IConfig::DnsIPv6Key: /* --dns-ipv6 */
         return set(doc, DnsConfig::kField, DnsConfig::kIPv6, enable);
 
+    case IConfig::HotStandbyKey: /* --hot-standby */
+        return set(doc, Pools::kHotStandby, enable);
+
     default:
         break;
     }
@@ -341,6 +352,24 @@ void xmrig::BaseTransform::transformUint64(rapidjson::Document &doc, int key, ui
     case IConfig::RetryPauseKey: /* --retry-pause */
         return set(doc, Pools::kRetryPause, arg);
 
+    case IConfig::MaxLineSizeKey: /* --max-line-size */
+        return set(doc, Pools::kMaxLineSize, arg);
+
+    case IConfig::SubmitWindowKey: /* --submit-window */
+        return set(doc, Pools::kSubmitWindow, arg);
+
+    case IConfig::SubmitInflightKey: /* --submit-inflight */
+        return set(doc, Pools::kSubmitInflight, arg);
+
+    case IConfig::SwitchLatencyKey: /* --switch-latency */
+        return set(doc, Pools::kSwitchLatency, arg);
+
+    case IConfig::SwitchRejectRateKey: /* --switch-reject-rate */
+        return set(doc, Pools::kSwitchRejectRate, arg);
+
+    case IConfig::SwitchJobTimeoutKey: /* --switch-job-timeout */
+        return set(doc, Pools::kSwitchJobTimeout, arg);
+
     case IConfig::DonateLevelKey: /* --donate-level */
         return set(doc, Pools::kDonateLevel, arg);
 
@@ -351,6 +380,9 @@ void xmrig::BaseTransform::transformUint64(rapidjson::Document &doc, int key, ui
         m_http = true;
         return set(doc, BaseConfig::kHttp, Http::kPort, arg);
 
+    case IConfig::LogFileSizeKey: /* --log-file-size */
+        return set(doc, BaseConfig::kLogFileSize, arg);
+
     case IConfig::PrintTimeKey: /* --print-time */
         return set(doc, BaseConfig::kPrintTime, arg);
 
@@ -89,6 +89,15 @@ public:
         HugePagesJitKey      = 1057,
         RotationKey          = 1058,
         DaemonJobTimeoutKey  = 1059,
+        MaxLineSizeKey       = 1060,
+        SubmitWindowKey      = 1061,
+        SubmitInflightKey    = 1062,
+        LogFileSizeKey       = 1063,
+        HotStandbyKey        = 1064,
+        SwitchLatencyKey     = 1065,
+        SwitchRejectRateKey  = 1066,
+        BenchSignatureKey    = 1067,
+        SwitchJobTimeoutKey  = 1068,
 
         // xmrig common
         CPUPriorityKey       = 1021,
@@ -16,6 +16,7 @@
  *   along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <uv.h>
 
 
@@ -60,6 +61,36 @@ size_t xmrig::DnsRecords::count(DnsRecord::Type type) const
 }
 
 
+std::vector<xmrig::DnsRecord> xmrig::DnsRecords::interleaved(DnsRecord::Type prefered) const
+{
+    const size_t ipv4 = m_ipv4.size();
+    const size_t ipv6 = m_ipv6.size();
+    const bool v6     = ipv6 && (prefered == DnsRecord::AAAA || Dns::config().isIPv6() || !ipv4);
+
+    const auto &first  = v6 ? m_ipv6 : m_ipv4;
+    const auto &second = v6 ? m_ipv4 : m_ipv6;
+
+    // Each family starts at a random record to keep spreading rigs across pool servers, same as get().
+    const size_t a = first.empty() ? 0 : static_cast<size_t>(rand()) % first.size();   // NOLINT(concurrency-mt-unsafe, cert-msc30-c, cert-msc50-cpp)
+    const size_t b = second.empty() ? 0 : static_cast<size_t>(rand()) % second.size(); // NOLINT(concurrency-mt-unsafe, cert-msc30-c, cert-msc50-cpp)
+
+    std::vector<DnsRecord> out;
+    out.reserve(ipv4 + ipv6);
+
+    for (size_t i = 0; i < std::max(first.size(), second.size()); ++i) {
+        if (i < first.size()) {
+            out.push_back(first[(a + i) % first.size()]);
+        }
+
+        if (i < second.size()) {
+            out.push_back(second[(b + i) % second.size()]);
+        }
+    }
+
+    return out;
+}
+
+
 void xmrig::DnsRecords::clear()
 {
     m_ipv4.clear();
@@ -33,6 +33,7 @@ public:
 
     const DnsRecord &get(DnsRecord::Type prefered = DnsRecord::Unknown) const;
     size_t count(DnsRecord::Type type = DnsRecord::Unknown) const;
+    std::vector<DnsRecord> interleaved(DnsRecord::Type prefered = DnsRecord::Unknown) const;
     void clear();
     void parse(addrinfo *res);
 
@@ -45,6 +45,11 @@ Storage<DnsUvBackend> &DnsUvBackend::getStorage()
 static addrinfo hints{};
 
 
+// Cached records are refreshed in the background once a quarter of the TTL is left, and expired records are
+// still served (for up to a day) while a new lookup is in flight, so reconnects never wait for the resolver.
+static constexpr uint64_t kMaxStale = 24 * 60 * 60 * 1000;
+
+
 } // namespace xmrig
 
 
@@ -76,18 +81,33 @@ xmrig::DnsUvBackend::~DnsUvBackend()
 std::shared_ptr<xmrig::DnsRequest> xmrig::DnsUvBackend::resolve(const String &host, IDnsListener *listener, uint64_t ttl)
 {
     auto req = std::make_shared<DnsRequest>(listener);
+    const uint64_t age = Chrono::currentMSecsSinceEpoch() - m_ts;
+
+    if (!m_records.isEmpty() && age <= ttl + kMaxStale) {
+        if (age > ttl - ttl / 4) {
+            refresh(host);
+        }
 
-    if (Chrono::currentMSecsSinceEpoch() - m_ts <= ttl && !m_records.isEmpty()) {
         req->listener->onResolved(m_records, 0, nullptr);
-    } else {
+    }
+    else {
         m_queue.emplace(req);
+        refresh(host);
     }
 
-    if (m_queue.size() == 1 && !resolve(host)) {
-        done();
+    return req;
+}
+
+
+void xmrig::DnsUvBackend::refresh(const String &host)
+{
+    if (m_req) {
+        return;
     }
 
-    return req;
+    if (!resolve(host)) {
+        done();
+    }
 }
 
 
@@ -121,17 +141,21 @@ void xmrig::DnsUvBackend::done()
 
 void xmrig::DnsUvBackend::onResolved(int status, addrinfo *res)
 {
-    m_ts = Chrono::currentMSecsSinceEpoch();
-
     if ((m_status = status) < 0) {
         return done();
     }
 
-    m_records.parse(res);
+    DnsRecords records;
+    records.parse(res);
 
-    if (m_records.isEmpty()) {
+    // A failed or empty answer keeps the previous records (and their age), the next lookup retries.
+    if (records.isEmpty()) {
         m_status = UV_EAI_NONAME;
     }
+    else {
+        m_records = std::move(records);
+        m_ts      = Chrono::currentMSecsSinceEpoch();
+    }
 
     done();
 }
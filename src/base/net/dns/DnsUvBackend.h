@@ -50,6 +50,7 @@ protected:
 private:
     bool resolve(const String &host);
     void done();
+    void refresh(const String &host);
     void onResolved(int status, addrinfo *res);
 
     static void onResolved(uv_getaddrinfo_t *req, int status, addrinfo *res);
@@ -22,6 +22,7 @@
 #include "3rdparty/rapidjson/writer.h"
 #include "base/io/log/Log.h"
 #include "base/net/http/HttpClient.h"
+#include "base/net/http/HttpClientPool.h"
 
 
 #ifdef XMRIG_FEATURE_TLS
@@ -105,7 +106,15 @@ void xmrig::fetch(const char *tag, FetchRequest &&req, const std::weak_ptr<IHttp
     }
 #   endif
 
-    HttpClient *client = nullptr;
+    HttpClient *client = req.keepAlive ? HttpClientPool::take(req) : nullptr;
+    if (client) {
+        client->userType = type;
+        client->rpcId    = rpcId;
+        client->request(tag, std::move(req), listener);
+
+        return;
+    }
+
 #   ifdef XMRIG_FEATURE_TLS
     if (req.tls) {
         client = new HttpsClient(tag, std::move(req), listener);
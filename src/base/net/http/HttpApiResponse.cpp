@@ -29,6 +29,16 @@ namespace xmrig {
 static const char *kError  = "error";
 static const char *kStatus = "status";
 
+
+static void write(const rapidjson::Document &doc, rapidjson::StringBuffer &buffer)
+{
+    rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+    writer.SetMaxDecimalPlaces(10);
+    writer.SetFormatOptions(rapidjson::kFormatSingleLineArray);
+
+    doc.Accept(writer);
+}
+
 } // namespace xmrig
 
 
@@ -47,13 +57,22 @@ xmrig::HttpApiResponse::HttpApiResponse(uint64_t id, int status) :
 }
 
 
+std::shared_ptr<const std::string> xmrig::HttpApiResponse::serialize() const
+{
+    using namespace rapidjson;
+
+    StringBuffer buffer(nullptr, 4096);
+    write(m_doc, buffer);
+
+    return std::make_shared<const std::string>(buffer.GetString(), buffer.GetSize());
+}
+
+
 void xmrig::HttpApiResponse::end()
 {
     using namespace rapidjson;
 
-    setHeader("Access-Control-Allow-Origin", "*");
-    setHeader("Access-Control-Allow-Methods", "GET, PUT, POST, DELETE");
-    setHeader("Access-Control-Allow-Headers", "Authorization, Content-Type");
+    setHeaders();
 
     if (statusCode() >= 400) {
         if (!m_doc.HasMember(kStatus)) {
@@ -72,11 +91,29 @@ void xmrig::HttpApiResponse::end()
     setHeader(HttpData::kContentType, HttpData::kApplicationJson);
 
     StringBuffer buffer(nullptr, 4096);
-    PrettyWriter<StringBuffer> writer(buffer);
-    writer.SetMaxDecimalPlaces(10);
-    writer.SetFormatOptions(kFormatSingleLineArray);
-
-    m_doc.Accept(writer);
+    write(m_doc, buffer);
 
     HttpResponse::end(buffer.GetString(), buffer.GetSize());
 }
+
+
+void xmrig::HttpApiResponse::end(const std::string &json)
+{
+    setHeaders();
+
+    if (json.empty()) {
+        return HttpResponse::end();
+    }
+
+    setHeader(HttpData::kContentType, HttpData::kApplicationJson);
+
+    HttpResponse::end(json.data(), json.size());
+}
+
+
+void xmrig::HttpApiResponse::setHeaders()
+{
+    setHeader("Access-Control-Allow-Origin", "*");
+    setHeader("Access-Control-Allow-Methods", "GET, PUT, POST, DELETE");
+    setHeader("Access-Control-Allow-Headers", "Authorization, Content-Type");
+}
@@ -25,6 +25,9 @@
 #include "base/net/http/HttpResponse.h"
 
 
+#include <memory>
+
+
 namespace xmrig {
 
 
@@ -36,9 +39,13 @@ public:
 
     inline rapidjson::Document &doc() { return m_doc; }
 
+    std::shared_ptr<const std::string> serialize() const;
     void end();
+    void end(const std::string &json);
 
 private:
+    void setHeaders();
+
     rapidjson::Document m_doc;
 };
 
@@ -21,9 +21,11 @@
 #include "base/net/http/HttpClient.h"
 #include "3rdparty/llhttp/llhttp.h"
 #include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
 #include "base/kernel/Platform.h"
 #include "base/net/dns/Dns.h"
 #include "base/net/dns/DnsRecords.h"
+#include "base/net/http/HttpClientPool.h"
 #include "base/net/tools/NetBuffer.h"
 #include "base/tools/Timer.h"
 
@@ -44,15 +46,17 @@ static const char *kCRLF = "\r\n";
 xmrig::HttpClient::HttpClient(const char *tag, FetchRequest &&req, const std::weak_ptr<IHttpListener> &listener) :
     HttpContext(HTTP_RESPONSE, listener),
     m_tag(tag),
+    m_key(req.keepAlive ? HttpClientPool::key(req) : std::string()),
     m_req(std::move(req))
 {
-    method  = m_req.method;
-    url     = std::move(m_req.path);
-    body    = std::move(m_req.body);
-    headers = std::move(m_req.headers);
+    setRequest();
+}
 
-    if (m_req.timeout) {
-        m_timer = std::make_shared<Timer>(this, m_req.timeout, 0);
+
+xmrig::HttpClient::~HttpClient()
+{
+    if (m_req.keepAlive) {
+        HttpClientPool::remove(this);
     }
 }
 
@@ -65,6 +69,43 @@ bool xmrig::HttpClient::connect()
 }
 
 
+void xmrig::HttpClient::request(const char *tag, FetchRequest &&req, const std::weak_ptr<IHttpListener> &listener)
+{
+    m_tag      = tag;
+    m_req      = std::move(req);
+    m_received = false;
+    m_reused   = true;
+
+    reset(listener);
+    setRequest();
+
+    // The connection is already established (and the TLS session too), only the request itself is sent.
+    HttpClient::handshake();
+}
+
+
+void xmrig::HttpClient::complete()
+{
+    if (m_timer) {
+        m_timer->stop();
+    }
+
+    if (!m_req.keepAlive) {
+        return;
+    }
+
+    if (!isKeepAlive()) {
+        return close();
+    }
+
+    // The connection may outlive the owner of the tag, errors on an idle connection are not interesting anyway.
+    m_tag       = Tags::network();
+    m_req.quiet = true;
+
+    HttpClientPool::release(this);
+}
+
+
 void xmrig::HttpClient::onResolved(const DnsRecords &records, int status, const char *error)
 {
     this->status = status;
@@ -94,7 +135,7 @@ void xmrig::HttpClient::onTimer(const Timer *)
 void xmrig::HttpClient::handshake()
 {
     headers.insert({ "Host",       host() });
-    headers.insert({ "Connection", "close" });
+    headers.insert({ "Connection", m_req.keepAlive ? "keep-alive" : "close" });
     headers.insert({ "User-Agent", Platform::userAgent().data() });
 
     if (!body.empty()) {
@@ -119,12 +160,53 @@ void xmrig::HttpClient::handshake()
 
 void xmrig::HttpClient::read(const char *data, size_t size)
 {
+    m_received = m_received || size > 0;
+
     if (!parse(data, size)) {
         close(UV_EPROTO);
     }
 }
 
 
+bool xmrig::HttpClient::retry()
+{
+    // A reused connection that the server closed while it was idle fails before any byte of the response
+    // arrives, the request was not processed and is sent again on another connection.
+    if (!m_reused || m_received || listener().expired()) {
+        return false;
+    }
+
+    const auto listener = this->listener();
+    reset({});
+    close();
+
+    HttpClientPool::addRetry();
+    fetch(m_tag, FetchRequest(m_req), listener, userType, rpcId);
+
+    return true;
+}
+
+
+void xmrig::HttpClient::setRequest()
+{
+    method  = m_req.method;
+    url     = m_req.path.data();
+    body    = m_req.body;
+    headers = m_req.headers;
+
+    if (!m_req.timeout) {
+        return;
+    }
+
+    if (!m_timer) {
+        m_timer = std::make_shared<Timer>(this, m_req.timeout, 0);
+    }
+    else {
+        m_timer->start(m_req.timeout, 0);
+    }
+}
+
+
 void xmrig::HttpClient::onConnect(uv_connect_t *req, int status)
 {
     auto client = static_cast<HttpClient *>(req->data);
@@ -146,6 +228,12 @@ void xmrig::HttpClient::onConnect(uv_connect_t *req, int status)
         return client->close(status);
     }
 
+    HttpClientPool::addConnection();
+
+    if (client->m_req.keepAlive && Platform::hasKeepalive()) {
+        uv_tcp_keepalive(client->m_tcp, 1, 60);
+    }
+
     uv_read_start(client->stream(), NetBuffer::onAlloc,
         [](uv_stream_t *tcp, ssize_t nread, const uv_buf_t *buf)
         {
@@ -153,7 +241,7 @@ void xmrig::HttpClient::onConnect(uv_connect_t *req, int status)
 
             if (nread >= 0) {
                 client->read(buf->base, static_cast<size_t>(nread));
-            } else {
+            } else if (!client->retry()) {
                 if (!client->isQuiet() && nread != UV_EOF) {
                     LOG_ERR("%s " RED("read error: ") RED_BOLD("\"%s\""), client->tag(), uv_strerror(static_cast<int>(nread)));
                 }
@@ -41,29 +41,40 @@ public:
     XMRIG_DISABLE_COPY_MOVE_DEFAULT(HttpClient);
 
     HttpClient(const char *tag, FetchRequest &&req, const std::weak_ptr<IHttpListener> &listener);
-    ~HttpClient() override = default;
+    ~HttpClient() override;
 
+    inline bool isAlive() const                 { return HttpContext::get(id()) == this; }
     inline bool isQuiet() const                 { return m_req.quiet; }
     inline const char *host() const override    { return m_req.host; }
     inline const char *tag() const              { return m_tag; }
+    inline const std::string &key() const       { return m_key; }
     inline uint16_t port() const override       { return m_req.port; }
 
     bool connect();
+    void request(const char *tag, FetchRequest &&req, const std::weak_ptr<IHttpListener> &listener);
 
 protected:
+    void complete() override;
     void onResolved(const DnsRecords &records, int status, const char *error) override;
     void onTimer(const Timer *timer) override;
 
     virtual void handshake();
     virtual void read(const char *data, size_t size);
 
+    bool retry();
+
 protected:
     inline const FetchRequest &req() const  { return m_req; }
 
 private:
     static void onConnect(uv_connect_t *req, int status);
 
+    void setRequest();
+
+    bool m_received         = false;
+    bool m_reused           = false;
     const char *m_tag;
+    const std::string m_key;
     FetchRequest m_req;
     std::shared_ptr<DnsRequest> m_dns;
     std::shared_ptr<Timer> m_timer;
@@ -0,0 +1,121 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "base/net/http/HttpClientPool.h"
+#include "base/net/http/HttpClient.h"
+#include "base/tools/Chrono.h"
+
+
+namespace xmrig {
+
+
+// Servers close idle keep-alive connections after their own timeout, older connections are closed instead of reused.
+static constexpr uint64_t kIdleTimeout  = 30 * 1000;
+static constexpr size_t kMaxIdle        = 4;
+
+
+std::map<std::string, std::list<HttpClientPool::Idle> > HttpClientPool::m_idle;
+uint64_t HttpClientPool::m_connections  = 0;
+uint64_t HttpClientPool::m_resumptions  = 0;
+uint64_t HttpClientPool::m_retries      = 0;
+uint64_t HttpClientPool::m_reuses       = 0;
+
+
+} // namespace xmrig
+
+
+xmrig::HttpClient *xmrig::HttpClientPool::take(const FetchRequest &req)
+{
+    auto it = m_idle.find(key(req));
+    if (it == m_idle.end()) {
+        return nullptr;
+    }
+
+    auto &list         = it->second;
+    const uint64_t now = Chrono::steadyMSecs();
+    HttpClient *client = nullptr;
+
+    while (!list.empty() && !client) {
+        const Idle idle = list.front();
+        list.pop_front();
+
+        if (!idle.client->isAlive()) {
+            continue;
+        }
+
+        if (now - idle.ts > kIdleTimeout) {
+            idle.client->close();
+            continue;
+        }
+
+        client = idle.client;
+    }
+
+    if (list.empty()) {
+        m_idle.erase(it);
+    }
+
+    if (client) {
+        m_reuses++;
+    }
+
+    return client;
+}
+
+
+std::string xmrig::HttpClientPool::key(const FetchRequest &req)
+{
+    std::string out = req.tls ? "https://" : "http://";
+    out.append(req.host.data()).append(":").append(std::to_string(req.port));
+
+    if (!req.fingerprint.isNull()) {
+        out.append("/").append(req.fingerprint.data());
+    }
+
+    return out;
+}
+
+
+void xmrig::HttpClientPool::release(HttpClient *client)
+{
+    auto &list = m_idle[client->key()];
+    list.push_front({ client, Chrono::steadyMSecs() });
+
+    if (list.size() > kMaxIdle) {
+        HttpClient *oldest = list.back().client;
+        list.pop_back();
+
+        oldest->close();
+    }
+}
+
+
+void xmrig::HttpClientPool::remove(HttpClient *client)
+{
+    auto it = m_idle.find(client->key());
+    if (it == m_idle.end()) {
+        return;
+    }
+
+    it->second.remove_if([client](const Idle &idle) { return idle.client == client; });
+
+    if (it->second.empty()) {
+        m_idle.erase(it);
+    }
+}
@@ -0,0 +1,72 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef XMRIG_HTTPCLIENTPOOL_H
+#define XMRIG_HTTPCLIENTPOOL_H
+
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <string>
+
+
+namespace xmrig {
+
+
+class FetchRequest;
+class HttpClient;
+
+
+class HttpClientPool
+{
+public:
+    inline static uint64_t connections()    { return m_connections; }
+    inline static uint64_t resumptions()    { return m_resumptions; }
+    inline static uint64_t retries()        { return m_retries; }
+    inline static uint64_t reuses()         { return m_reuses; }
+
+    inline static void addConnection()      { m_connections++; }
+    inline static void addResumption()      { m_resumptions++; }
+    inline static void addRetry()           { m_retries++; }
+
+    static HttpClient *take(const FetchRequest &req);
+    static std::string key(const FetchRequest &req);
+    static void release(HttpClient *client);
+    static void remove(HttpClient *client);
+
+private:
+    struct Idle
+    {
+        HttpClient *client;
+        uint64_t ts;
+    };
+
+    static std::map<std::string, std::list<Idle> > m_idle;
+    static uint64_t m_connections;
+    static uint64_t m_resumptions;
+    static uint64_t m_retries;
+    static uint64_t m_reuses;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_HTTPCLIENTPOOL_H */
@@ -27,6 +27,7 @@
 
 #include <algorithm>
 #include <uv.h>
+#include <vector>
 
 
 namespace xmrig {
@@ -112,6 +113,12 @@ void xmrig::HttpContext::write(std::string &&data, bool close)
 }
 
 
+bool xmrig::HttpContext::isKeepAlive() const
+{
+    return llhttp_should_keep_alive(m_parser) == 1;
+}
+
+
 bool xmrig::HttpContext::isRequest() const
 {
     return m_parser->type == HTTP_REQUEST;
@@ -124,7 +131,10 @@ bool xmrig::HttpContext::parse(const char *data, size_t size)
         return true;
     }
 
-    return llhttp_execute(m_parser, data, size) == HPE_OK;
+    const llhttp_errno_t rc = llhttp_execute(m_parser, data, size);
+
+    // Pipelined data after a request with "Connection: close" is ignored, the connection is closed once the response is written.
+    return rc == HPE_OK || (rc == HPE_CLOSED_CONNECTION && isRequest());
 }
 
 
@@ -191,6 +201,34 @@ void xmrig::HttpContext::closeAll()
 }
 
 
+void xmrig::HttpContext::closeIdle()
+{
+    const uint64_t now = Chrono::steadyMSecs();
+    std::vector<HttpContext *> idle;
+
+    for (auto &kv : storage) {
+        if (kv.second->isRequest() && now - kv.second->m_timestamp > kKeepAliveTimeout) {
+            idle.emplace_back(kv.second);
+        }
+    }
+
+    for (auto ctx : idle) {
+        ctx->close();
+    }
+}
+
+
+void xmrig::HttpContext::reset(const std::weak_ptr<IHttpListener> &listener)
+{
+    status      = 0;
+    m_listener  = listener;
+    m_timestamp = Chrono::steadyMSecs();
+
+    headers.clear();
+    body.clear();
+}
+
+
 int xmrig::HttpContext::onHeaderField(llhttp_t *parser, const char *at, size_t length)
 {
     auto ctx = static_cast<HttpContext*>(parser->data);
@@ -227,11 +265,21 @@ int xmrig::HttpContext::onHeaderValue(llhttp_t *parser, const char *at, size_t l
 
 void xmrig::HttpContext::attach(llhttp_settings_t *settings)
 {
-    settings->on_message_begin  = nullptr;
     settings->on_status         = nullptr;
     settings->on_chunk_header   = nullptr;
     settings->on_chunk_complete = nullptr;
 
+    settings->on_message_begin = [](llhttp_t *parser) -> int
+    {
+        auto ctx = static_cast<HttpContext*>(parser->data);
+
+        if (parser->type == HTTP_REQUEST) {
+            ctx->reset(ctx->m_listener);
+        }
+
+        return 0;
+    };
+
     settings->on_url = [](llhttp_t *parser, const char *at, size_t length) -> int
     {
         static_cast<HttpContext*>(parser->data)->url = std::string(at, length);
@@ -269,10 +317,17 @@ void xmrig::HttpContext::attach(llhttp_settings_t *settings)
         auto listener = ctx->httpListener();
 
         if (listener) {
+            ++ctx->m_requests;
             listener->onHttpData(*ctx);
-            ctx->m_listener.reset();
+
+            // Server connections keep the listener for the next request on a keep-alive connection.
+            if (parser->type != HTTP_REQUEST) {
+                ctx->m_listener.reset();
+            }
         }
 
+        ctx->complete();
+
         return 0;
     };
 }
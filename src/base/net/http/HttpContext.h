@@ -48,6 +48,9 @@ class HttpContext : public HttpData
 public:
     XMRIG_DISABLE_COPY_MOVE_DEFAULT(HttpContext)
 
+    static constexpr uint64_t kKeepAliveTimeout = 15 * 1000;
+    static constexpr uint32_t kMaxRequests      = 1000;
+
     HttpContext(int parser_type, const std::weak_ptr<IHttpListener> &listener);
     ~HttpContext() override;
 
@@ -58,9 +61,11 @@ public:
     inline const char *tlsFingerprint() const override  { return nullptr; }
     inline const char *tlsVersion() const override      { return nullptr; }
     inline uint16_t port() const override               { return 0; }
+    inline uint32_t requests() const                    { return m_requests; }
 
     void write(std::string &&data, bool close) override;
 
+    bool isKeepAlive() const;
     bool isRequest() const override;
     bool parse(const char *data, size_t size);
     std::string ip() const override;
@@ -69,8 +74,15 @@ public:
 
     static HttpContext *get(uint64_t id);
     static void closeAll();
+    static void closeIdle();
 
 protected:
+    inline const std::weak_ptr<IHttpListener> &listener() const { return m_listener; }
+
+    virtual void complete() {}
+
+    void reset(const std::weak_ptr<IHttpListener> &listener);
+
     uv_tcp_t *m_tcp;
 
 private:
@@ -83,7 +95,8 @@ private:
     void setHeader();
 
     bool m_wasHeaderValue           = false;
-    const uint64_t m_timestamp;
+    uint32_t m_requests             = 0;
+    uint64_t m_timestamp;
     llhttp_t *m_parser;
     std::string m_lastHeaderField;
     std::string m_lastHeaderValue;
@@ -25,14 +25,28 @@
 
 #include "base/net/https/HttpsClient.h"
 #include "base/io/log/Log.h"
+#include "base/net/http/HttpClientPool.h"
 #include "base/tools/Cvt.h"
 
 
+#include <map>
+
+
 #ifdef _MSC_VER
 #   define strncasecmp(x,y,z) _strnicmp(x,y,z)
 #endif
 
 
+namespace xmrig {
+
+
+// Last TLS session per server, a new connection to the same server resumes it instead of a full handshake.
+static std::map<std::string, SSL_SESSION *> sessions;
+
+
+} // namespace xmrig
+
+
 xmrig::HttpsClient::HttpsClient(const char *tag, FetchRequest &&req, const std::weak_ptr<IHttpListener> &listener) :
     HttpClient(tag, std::move(req), listener)
 {
@@ -46,6 +60,11 @@ xmrig::HttpsClient::HttpsClient(const char *tag, FetchRequest &&req, const std::
     m_write = BIO_new(BIO_s_mem());
     m_read  = BIO_new(BIO_s_mem());
     SSL_CTX_set_options(m_ctx, SSL_OP_NO_SSLv2 | SSL_OP_NO_SSLv3);
+
+    if (!key().empty()) {
+        SSL_CTX_set_session_cache_mode(m_ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+        SSL_CTX_sess_set_new_cb(m_ctx, onNewSession);
+    }
 }
 
 
@@ -56,6 +75,13 @@ xmrig::HttpsClient::~HttpsClient()
     }
 
     if (m_ssl) {
+        // Without a shutdown OpenSSL marks the session as not resumable, keep-alive connections are routinely
+        // closed without close_notify.
+        if (m_ready) {
+            SSL_set_quiet_shutdown(m_ssl, 1);
+            SSL_shutdown(m_ssl);
+        }
+
         SSL_free(m_ssl);
     }
 }
@@ -86,6 +112,15 @@ void xmrig::HttpsClient::handshake()
     SSL_set_bio(m_ssl, m_read, m_write);
     SSL_set_tlsext_host_name(m_ssl, host());
 
+    if (!key().empty()) {
+        SSL_set_app_data(m_ssl, this);
+
+        const auto it = sessions.find(key());
+        if (it != sessions.end()) {
+            SSL_set_session(m_ssl, it->second);
+        }
+    }
+
     SSL_do_handshake(m_ssl);
 
     flush(false);
@@ -111,6 +146,10 @@ void xmrig::HttpsClient::read(const char *data, size_t size)
             X509_free(cert);
             m_ready = true;
 
+            if (SSL_session_reused(m_ssl)) {
+                HttpClientPool::addResumption();
+            }
+
             HttpClient::handshake();
       }
 
@@ -124,7 +163,7 @@ void xmrig::HttpsClient::read(const char *data, size_t size)
         HttpClient::read(buf, static_cast<size_t>(rc));
     }
 
-    if (rc == 0) {
+    if (rc == 0 && !retry()) {
         close(UV_EOF);
     }
 }
@@ -139,6 +178,24 @@ void xmrig::HttpsClient::write(std::string &&data, bool close)
 }
 
 
+int xmrig::HttpsClient::onNewSession(SSL *ssl, SSL_SESSION *session)
+{
+    auto client = static_cast<HttpsClient *>(SSL_get_app_data(ssl));
+    if (!client) {
+        return 0;
+    }
+
+    SSL_SESSION *&cached = sessions[client->key()];
+    if (cached) {
+        SSL_SESSION_free(cached);
+    }
+
+    cached = session;
+
+    return 1;
+}
+
+
 bool xmrig::HttpsClient::verify(X509 *cert)
 {
     if (cert == nullptr) {
@@ -25,6 +25,7 @@
 using BIO       = struct bio_st;
 using SSL_CTX   = struct ssl_ctx_st;
 using SSL       = struct ssl_st;
+using SSL_SESSION = struct ssl_session_st;
 using X509      = struct x509_st;
 
 
@@ -51,6 +52,8 @@ protected:
     void read(const char *data, size_t size) override;
 
 private:
+    static int onNewSession(SSL *ssl, SSL_SESSION *session);
+
     void write(std::string &&data, bool close) override;
 
     bool verify(X509 *cert);
@@ -16,6 +16,9 @@
  *   along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+
+
 #include "base/net/stratum/BaseClient.h"
 #include "3rdparty/fmt/core.h"
 #include "3rdparty/rapidjson/document.h"
@@ -23,6 +26,7 @@
 #include "base/io/log/Log.h"
 #include "base/io/log/Tags.h"
 #include "base/kernel/interfaces/IClientListener.h"
+#include "base/net/stratum/JobLatency.h"
 #include "base/net/stratum/SubmitResult.h"
 
 
@@ -65,6 +69,7 @@ bool xmrig::BaseClient::handleResponse(int64_t id, const rapidjson::Value &resul
     auto it = m_callbacks.find(id);
     if (it != m_callbacks.end()) {
         const uint64_t elapsed = Chrono::steadyMSecs() - it->second.ts;
+        addLatency(elapsed);
 
         if (error.IsObject()) {
             it->second.callback(error, false, elapsed);
@@ -87,6 +92,8 @@ bool xmrig::BaseClient::handleSubmitResponse(int64_t id, const char *error)
     auto it = m_results.find(id);
     if (it != m_results.end()) {
         it->second.done();
+        addLatency(it->second.elapsed);
+        JobLatency::submitted(it->second.latency);
         m_listener->onResultAccepted(this, it->second, error);
         m_results.erase(it);
 
@@ -95,3 +102,11 @@ bool xmrig::BaseClient::handleSubmitResponse(int64_t id, const char *error)
 
     return false;
 }
+
+
+void xmrig::BaseClient::addLatency(uint64_t elapsed)
+{
+    // Exponential moving average over roughly the last 8 round trips, the strategies
+    // compare pools by it so a single slow reply must not trigger a switch.
+    m_latency = m_latency ? (m_latency * 7 + elapsed) / 8 : std::max<uint64_t>(elapsed, 1);
+}
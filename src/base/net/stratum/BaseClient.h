@@ -49,6 +49,7 @@ protected:
     inline const String &ip() const override                   { return m_ip; }
     inline int id() const override                             { return m_id; }
     inline int64_t sequence() const override                   { return m_sequence; }
+    inline uint64_t latency() const override                   { return m_latency; }
     inline void setAlgo(const Algorithm &algo) override        { m_pool.setAlgo(algo); }
     inline void setEnabled(bool enabled) override              { m_enabled = enabled; }
     inline void setProxy(const ProxyUrl &proxy) override       { m_pool.setProxy(proxy); }
@@ -80,6 +81,7 @@ protected:
 
     virtual bool handleResponse(int64_t id, const rapidjson::Value &result, const rapidjson::Value &error);
     bool handleSubmitResponse(int64_t id, const char *error = nullptr);
+    void addLatency(uint64_t elapsed);
 
     bool m_quiet                    = false;
     IClientListener *m_listener;
@@ -96,6 +98,7 @@ protected:
     String m_password;
     String m_rigId;
     String m_user;
+    uint64_t m_latency              = 0;
     uint64_t m_retryPause           = 5000;
 
     static int64_t m_sequence;
@@ -17,6 +17,7 @@
  *   along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <cassert>
 #include <cinttypes>
 #include <iterator>
@@ -50,6 +51,7 @@
 #include "base/tools/Chrono.h"
 #include "base/tools/cryptonote/BlobReader.h"
 #include "base/tools/Cvt.h"
+#include "base/tools/Timer.h"
 #include "net/JobResult.h"
 
 
@@ -61,6 +63,8 @@
 namespace xmrig {
 
 Storage<Client> Client::m_storage;
+uint32_t Client::m_submitInflight   = 0;
+uint32_t Client::m_submitWindow     = 0;
 
 } /* namespace xmrig */
 
@@ -90,10 +94,19 @@ xmrig::Client::Client(int id, const char *agent, IClientListener *listener) :
 
 xmrig::Client::~Client()
 {
+    delete m_attemptTimer;
+    delete m_submitTimer;
     delete m_socket;
 }
 
 
+void xmrig::Client::setSubmitPolicy(uint32_t window, uint32_t inflight)
+{
+    m_submitWindow   = window;
+    m_submitInflight = inflight;
+}
+
+
 bool xmrig::Client::disconnect()
 {
     m_keepAlive = 0;
@@ -239,7 +252,11 @@ int64_t xmrig::Client::submit(const JobResult &result)
     m_results[m_sequence] = SubmitResult(m_sequence, result.diff, result.actualDiff(), 0, result.backend);
 #   endif
 
-    return send(doc);
+    if (m_submitWindow == 0 && m_submitInflight == 0) {
+        return send(doc);
+    }
+
+    return enqueue(doc);
 }
 
 
@@ -307,6 +324,20 @@ void xmrig::Client::tick(uint64_t now)
 }
 
 
+void xmrig::Client::onTimer(const Timer *timer)
+{
+    if (timer == m_attemptTimer) {
+        if (m_state == ConnectingState) {
+            connectNext();
+        }
+
+        return;
+    }
+
+    flushSubmits();
+}
+
+
 void xmrig::Client::onResolved(const DnsRecords &records, int status, const char *error)
 {
     m_dns.reset();
@@ -324,10 +355,19 @@ void xmrig::Client::onResolved(const DnsRecords &records, int status, const char
         return reconnect();
     }
 
-    const auto &record = records.get();
-    m_ip = record.ip();
+    // Happy eyeballs (RFC 8305): addresses of both families are interleaved and a new attempt is started every
+    // kAttemptDelay ms (or as soon as one fails) until the first connection succeeds.
+    m_candidates = records.interleaved();
+    m_candidate  = 0;
+
+    if (m_candidates.empty()) {
+        return reconnect();
+    }
 
-    connect(record.addr(m_socks5 ? m_pool.proxy().port() : m_pool.port()));
+    m_ip = m_candidates.front().ip();
+
+    setState(ConnectingState);
+    connectNext();
 }
 
 
@@ -337,6 +377,22 @@ bool xmrig::Client::close()
         return m_socket != nullptr;
     }
 
+    // While connecting, one of the pending attempts is closed the regular way so onClose() still follows.
+    if (!m_socket && !m_attempts.empty()) {
+        m_socket = m_attempts.back();
+        m_attempts.pop_back();
+    }
+
+    abortAttempts();
+
+    // Every attempt has already failed, there is no socket to wait for so the reconnect starts right away.
+    if (m_state == ConnectingState && m_socket == nullptr) {
+        setState(UnconnectedState);
+        reconnect();
+
+        return true;
+    }
+
     if (m_state == UnconnectedState || m_socket == nullptr) {
         return false;
     }
@@ -417,6 +473,7 @@ bool xmrig::Client::parseJob(const rapidjson::Value &params, int *code)
         return false;
     }
 
+    job.setNextSeedHash(Json::getString(params, "next_seed_hash"));
     job.setSigKey(Json::getString(params, "sig_key"));
 
     m_job.setClientId(m_rpcId);
@@ -495,6 +552,37 @@ bool xmrig::Client::verifyAlgorithm(const Algorithm &algorithm, const char *algo
 }
 
 
+bool xmrig::Client::transmit(size_t size)
+{
+    LOG_DEBUG("[%s] send (%d bytes): \"%.*s\"", url(), size, static_cast<int>(size) - 1, m_sendBuf.data());
+
+#   ifdef XMRIG_FEATURE_TLS
+    if (isTLS()) {
+        if (!m_tls->send(m_sendBuf.data(), size)) {
+            return false;
+        }
+    }
+    else
+#   endif
+    {
+        if (state() != ConnectedState || !uv_is_writable(stream())) {
+            LOG_DEBUG_ERR("[%s] send failed, invalid state: %d", url(), m_state);
+            return false;
+        }
+
+        uv_buf_t buf = uv_buf_init(m_sendBuf.data(), (unsigned int) size);
+
+        if (!write(buf)) {
+            return false;
+        }
+    }
+
+    m_expire = Chrono::steadyMSecs() + kResponseTimeout;
+
+    return true;
+}
+
+
 bool xmrig::Client::write(const uv_buf_t &buf)
 {
     const int rc = uv_try_write(stream(), &buf, 1);
@@ -512,6 +600,39 @@ bool xmrig::Client::write(const uv_buf_t &buf)
 }
 
 
+int64_t xmrig::Client::enqueue(const rapidjson::Value &obj)
+{
+    using namespace rapidjson;
+
+    if (state() != ConnectedState) {
+        return -1;
+    }
+
+    StringBuffer buffer(nullptr, 512);
+    Writer<StringBuffer> writer(buffer);
+    obj.Accept(writer);
+
+    m_submits.emplace_back(buffer.GetString(), buffer.GetSize());
+    m_submits.back() += '\n';
+
+    const int64_t seq = m_sequence++;
+
+    // The first queued share opens the coalescing window, shares held back by the in-flight limit are sent from parseResponse().
+    if (m_submitWindow == 0) {
+        flushSubmits();
+    }
+    else if (m_submits.size() == 1) {
+        if (!m_submitTimer) {
+            m_submitTimer = new Timer(this);
+        }
+
+        m_submitTimer->singleShot(m_submitWindow);
+    }
+
+    return seq;
+}
+
+
 int xmrig::Client::resolve(const String &host)
 {
     setState(HostLookupState);
@@ -530,52 +651,109 @@ int xmrig::Client::resolve(const String &host)
 
 int64_t xmrig::Client::send(size_t size)
 {
-    LOG_DEBUG("[%s] send (%d bytes): \"%.*s\"", url(), size, static_cast<int>(size) - 1, m_sendBuf.data());
+    if (!transmit(size)) {
+        return -1;
+    }
 
-#   ifdef XMRIG_FEATURE_TLS
-    if (isTLS()) {
-        if (!m_tls->send(m_sendBuf.data(), size)) {
-            return -1;
-        }
+    return m_sequence++;
+}
+
+
+void xmrig::Client::abortAttempts()
+{
+    if (m_attemptTimer) {
+        m_attemptTimer->stop();
     }
-    else
-#   endif
-    {
-        if (state() != ConnectedState || !uv_is_writable(stream())) {
-            LOG_DEBUG_ERR("[%s] send failed, invalid state: %d", url(), m_state);
-            return -1;
-        }
 
-        uv_buf_t buf = uv_buf_init(m_sendBuf.data(), (unsigned int) size);
+    for (uv_tcp_t *socket : m_attempts) {
+        uv_close(reinterpret_cast<uv_handle_t *>(socket), [](uv_handle_t *handle) { delete reinterpret_cast<uv_tcp_t *>(handle); });
+    }
 
-        if (!write(buf)) {
-            return -1;
+    m_attempts.clear();
+}
+
+
+bool xmrig::Client::connectNext()
+{
+    if (m_candidate >= m_candidates.size()) {
+        return false;
+    }
+
+    connect(m_candidates[m_candidate++].addr(m_socks5 ? m_pool.proxy().port() : m_pool.port()));
+
+    if (m_candidate < m_candidates.size()) {
+        if (!m_attemptTimer) {
+            m_attemptTimer = new Timer(this);
         }
+
+        m_attemptTimer->singleShot(kAttemptDelay);
     }
 
-    m_expire = Chrono::steadyMSecs() + kResponseTimeout;
-    return m_sequence++;
+    return true;
 }
 
 
 void xmrig::Client::connect(const sockaddr *addr)
 {
-    setState(ConnectingState);
-
     auto req = new uv_connect_t;
     req->data = m_storage.ptr(m_key);
 
-    m_socket = new uv_tcp_t;
-    m_socket->data = m_storage.ptr(m_key);
+    auto socket = new uv_tcp_t;
+    socket->data = m_storage.ptr(m_key);
 
-    uv_tcp_init(uv_default_loop(), m_socket);
-    uv_tcp_nodelay(m_socket, 1);
+    uv_tcp_init(uv_default_loop(), socket);
+    uv_tcp_nodelay(socket, 1);
 
     if (Platform::hasKeepalive()) {
-        uv_tcp_keepalive(m_socket, 1, 60);
+        uv_tcp_keepalive(socket, 1, 60);
     }
 
-    uv_tcp_connect(req, m_socket, addr, onConnect);
+    m_attempts.push_back(socket);
+
+    const int rc = uv_tcp_connect(req, socket, addr, onConnect);
+    if (rc < 0) {
+        delete req;
+
+        onConnect(socket, rc);
+    }
+}
+
+
+void xmrig::Client::flushSubmits()
+{
+    while (!m_submits.empty() && state() == ConnectedState) {
+        // Queued shares already have their SubmitResult, so everything else in m_results is waiting for a response.
+        const size_t inflight = m_results.size() > m_submits.size() ? m_results.size() - m_submits.size() : 0;
+        if (m_submitInflight && inflight >= m_submitInflight) {
+            return;
+        }
+
+        const size_t limit = m_submitInflight ? m_submitInflight - inflight : m_submits.size();
+        size_t count       = 0;
+        size_t size        = 0;
+
+        while (count < limit && count < m_submits.size() && (count == 0 || size + m_submits[count].size() <= kMaxSendBufferSize)) {
+            size += m_submits[count++].size();
+        }
+
+        if (size + 1 > m_sendBuf.size()) {
+            m_sendBuf.resize((size / 1024 + 1) * 1024);
+        }
+
+        char *out = m_sendBuf.data();
+        for (size_t i = 0; i < count; ++i) {
+            memcpy(out, m_submits.front().data(), m_submits.front().size());
+            out += m_submits.front().size();
+
+            m_submits.pop_front();
+        }
+
+        *out = '\0';
+
+        if (!transmit(size)) {
+            return;
+        }
+    }
 }
 
 
@@ -619,7 +797,15 @@ bool xmrig::Client::parseLogin(const rapidjson::Value &result, int *code)
 void xmrig::Client::login()
 {
     using namespace rapidjson;
+
+    // Queued shares carry the session id and job ids of the previous connection, the pool would reject them.
+    if (!m_submits.empty() && !isQuiet()) {
+        LOG_WARN("%s " YELLOW("%zu queued share(s) lost on reconnect"), tag(), m_submits.size());
+    }
+
+    m_callbacks.clear();
     m_results.clear();
+    m_submits.clear();
 
     Document doc(kObjectType);
     auto &allocator = doc.GetAllocator();
@@ -659,6 +845,67 @@ void xmrig::Client::onClose()
 }
 
 
+void xmrig::Client::onConnect(uv_tcp_t *socket, int status)
+{
+    // Attempts that lost the race (or were aborted by close()) are already closing.
+    if (std::find(m_attempts.begin(), m_attempts.end(), socket) == m_attempts.end()) {
+        return;
+    }
+
+    if (status < 0) {
+        if (m_state == ConnectingState && (m_attempts.size() > 1 || connectNext())) {
+            m_attempts.erase(std::find(m_attempts.begin(), m_attempts.end(), socket));
+            uv_close(reinterpret_cast<uv_handle_t *>(socket), [](uv_handle_t *handle) { delete reinterpret_cast<uv_tcp_t *>(handle); });
+
+            // The next candidate may have failed synchronously too, leaving no live attempt behind.
+            if (!m_attempts.empty() || m_state != ConnectingState || connectNext()) {
+                return;
+            }
+        }
+
+        if (!isQuiet()) {
+            LOG_ERR("%s %s " RED("connect error: ") RED_BOLD("\"%s\""), tag(), ip().data(), uv_strerror(status));
+        }
+
+        if (m_state != ConnectingState) {
+            return;
+        }
+
+        close();
+        return;
+    }
+
+    m_attempts.erase(std::find(m_attempts.begin(), m_attempts.end(), socket));
+    m_socket = socket;
+    abortAttempts();
+
+    if (m_state == ConnectedState) {
+        return;
+    }
+
+    sockaddr_storage addr{};
+    int size = sizeof(addr);
+    char ip[INET6_ADDRSTRLEN]{};
+
+    if (uv_tcp_getpeername(socket, reinterpret_cast<sockaddr *>(&addr), &size) == 0) {
+        if (addr.ss_family == AF_INET6) {
+            uv_ip6_name(reinterpret_cast<sockaddr_in6 *>(&addr), ip, sizeof(ip));
+        }
+        else {
+            uv_ip4_name(reinterpret_cast<sockaddr_in *>(&addr), ip, sizeof(ip));
+        }
+
+        m_ip = static_cast<const char *>(ip);
+    }
+
+    setState(ConnectedState);
+
+    uv_read_start(stream(), NetBuffer::onAlloc, onRead);
+
+    handshake();
+}
+
+
 void xmrig::Client::parse(char *line, size_t len)
 {
     startTimeout();
@@ -820,6 +1067,12 @@ void xmrig::Client::parseResponse(int64_t id, const rapidjson::Value &result, co
 
         if (m_id == 1 || isCriticalError(message)) {
             close();
+
+            return;
+        }
+
+        if (!m_submits.empty()) {
+            flushSubmits();
         }
 
         return;
@@ -851,17 +1104,40 @@ void xmrig::Client::parseResponse(int64_t id, const rapidjson::Value &result, co
     }
 
     handleSubmitResponse(id);
+
+    if (!m_submits.empty()) {
+        flushSubmits();
+    }
 }
 
 
 void xmrig::Client::ping()
 {
+    // The reply is only used to measure the round trip, see BaseClient::handleResponse().
+    m_callbacks.insert({ m_sequence, SendResult([](const rapidjson::Value &, bool, uint64_t) {}) });
+
     send(snprintf(m_sendBuf.data(), m_sendBuf.size(), "{\"id\":%" PRId64 ",\"jsonrpc\":\"2.0\",\"method\":\"keepalived\",\"params\":{\"id\":\"%s\"}}\n", m_sequence, m_rpcId.data()));
 
     m_keepAlive = 0;
 }
 
 
+bool xmrig::Client::readLines(char *data, size_t size)
+{
+    if (m_reader.parse(data, size)) {
+        return true;
+    }
+
+    if (!isQuiet()) {
+        LOG_ERR("%s " RED("line exceeds max-line-size limit of ") RED_BOLD("%zu") RED(" bytes"), tag(), LineReader::maxSize());
+    }
+
+    close();
+
+    return false;
+}
+
+
 void xmrig::Client::read(ssize_t nread, const uv_buf_t *buf)
 {
     const auto size = static_cast<size_t>(nread);
@@ -907,7 +1183,7 @@ void xmrig::Client::read(ssize_t nread, const uv_buf_t *buf)
     else
 #   endif
     {
-        m_reader.parse(buf->base, size);
+        readLines(buf->base, size);
     }
 }
 
@@ -1014,38 +1290,14 @@ void xmrig::Client::onClose(uv_handle_t *handle)
 void xmrig::Client::onConnect(uv_connect_t *req, int status)
 {
     auto client = getClient(req->data);
+    auto socket = reinterpret_cast<uv_tcp_t *>(req->handle);
     delete req;
 
     if (!client) {
         return;
     }
 
-    if (status < 0) {
-        if (!client->isQuiet()) {
-            LOG_ERR("%s %s " RED("connect error: ") RED_BOLD("\"%s\""), client->tag(), client->ip().data(), uv_strerror(status));
-        }
-
-        if (client->state() == ReconnectingState || client->state() == ClosingState) {
-            return;
-        }
-
-        if (client->state() != ConnectingState) {
-            return;
-        }
-
-        client->close();
-        return;
-    }
-
-    if (client->state() == ConnectedState) {
-        return;
-    }
-
-    client->setState(ConnectedState);
-
-    uv_read_start(client->stream(), NetBuffer::onAlloc, onRead);
-
-    client->handshake();
+    client->onConnect(socket, status);
 }
 
 
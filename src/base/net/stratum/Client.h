@@ -22,13 +22,17 @@
 
 
 #include <bitset>
+#include <deque>
 #include <map>
+#include <string>
 #include <uv.h>
 #include <vector>
 
 
 #include "base/kernel/interfaces/IDnsListener.h"
 #include "base/kernel/interfaces/ILineListener.h"
+#include "base/kernel/interfaces/ITimerListener.h"
+#include "base/net/dns/DnsRecord.h"
 #include "base/net/stratum/BaseClient.h"
 #include "base/net/stratum/Job.h"
 #include "base/net/stratum/Pool.h"
@@ -49,11 +53,12 @@ class IClientListener;
 class JobResult;
 
 
-class Client : public BaseClient, public IDnsListener, public ILineListener
+class Client : public BaseClient, public IDnsListener, public ILineListener, public ITimerListener
 {
 public:
     XMRIG_DISABLE_COPY_MOVE_DEFAULT(Client)
 
+    constexpr static uint64_t kAttemptDelay     = 250;
     constexpr static uint64_t kConnectTimeout   = 20 * 1000;
     constexpr static uint64_t kResponseTimeout  = 20 * 1000;
     constexpr static size_t kMaxSendBufferSize  = 1024 * 16;
@@ -61,6 +66,8 @@ public:
     Client(int id, const char *agent, IClientListener *listener);
     ~Client() override;
 
+    static void setSubmitPolicy(uint32_t window, uint32_t inflight);
+
 protected:
     bool disconnect() override;
     bool isTLS() const override;
@@ -75,6 +82,7 @@ protected:
     void tick(uint64_t now) override;
 
     void onResolved(const DnsRecords &records, int status, const char *error) override;
+    void onTimer(const Timer *timer) override;
 
     inline bool hasExtension(Extension extension) const noexcept override   { return m_extensions.test(extension); }
     inline const char *mode() const override                                { return "pool"; }
@@ -97,14 +105,21 @@ private:
     class Socks5;
     class Tls;
 
+    bool connectNext();
     bool parseJob(const rapidjson::Value &params, int *code);
+    bool readLines(char *data, size_t size);
     bool send(BIO *bio);
+    bool transmit(size_t size);
     bool verifyAlgorithm(const Algorithm &algorithm, const char *algo) const;
     bool write(const uv_buf_t &buf);
     int resolve(const String &host);
+    int64_t enqueue(const rapidjson::Value &obj);
     int64_t send(size_t size);
+    void abortAttempts();
     void connect(const sockaddr *addr);
+    void flushSubmits();
     void handshake();
+    void onConnect(uv_tcp_t *socket, int status);
     void parse(char *line, size_t len);
     void parseExtensions(const rapidjson::Value &result);
     void parseResponse(int64_t id, const rapidjson::Value &result, const rapidjson::Value &error);
@@ -130,10 +145,16 @@ private:
     LineReader m_reader;
     Socks5 *m_socks5            = nullptr;
     std::bitset<EXT_MAX> m_extensions;
+    std::deque<std::string> m_submits;
     std::shared_ptr<DnsRequest> m_dns;
+    size_t m_candidate          = 0;
     std::vector<char> m_sendBuf;
     std::vector<char> m_tempBuf;
+    std::vector<DnsRecord> m_candidates;
+    std::vector<uv_tcp_t *> m_attempts;
     String m_rpcId;
+    Timer *m_attemptTimer       = nullptr;
+    Timer *m_submitTimer        = nullptr;
     Tls *m_tls                  = nullptr;
     uint64_t m_expire           = 0;
     uint64_t m_jobs             = 0;
@@ -142,6 +163,8 @@ private:
     uv_tcp_t *m_socket          = nullptr;
 
     static Storage<Client> m_storage;
+    static uint32_t m_submitInflight;
+    static uint32_t m_submitWindow;
 };
 
 
@@ -480,6 +480,7 @@ bool xmrig::DaemonClient::parseJob(const rapidjson::Value &params, int *code)
     }
 
     job.setSeedHash(Json::getString(params, "seed_hash"));
+    job.setNextSeedHash(Json::getString(params, "next_seed_hash"));
     job.setHeight(Json::getUint64(params, kHeight));
     job.setDiff(Json::getUint64(params, "difficulty"));
 
@@ -565,6 +566,8 @@ int64_t xmrig::DaemonClient::getBlockTemplate()
 int64_t xmrig::DaemonClient::rpcSend(const rapidjson::Document &doc, const std::map<std::string, std::string> &headers)
 {
     FetchRequest req(HTTP_POST, m_pool.host(), m_pool.port(), kJsonRPC, doc, m_pool.isTLS(), isQuiet());
+    req.keepAlive = true;
+
     for (const auto &header : headers) {
         req.headers.insert(header);
     }
@@ -603,6 +606,8 @@ void xmrig::DaemonClient::retry()
 void xmrig::DaemonClient::send(const char *path)
 {
     FetchRequest req(HTTP_GET, m_pool.host(), m_pool.port(), path, m_pool.isTLS(), isQuiet());
+    req.keepAlive = true;
+
     fetch(tag(), std::move(req), m_httpListener);
 }
 
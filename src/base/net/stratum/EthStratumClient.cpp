@@ -156,6 +156,7 @@ bool xmrig::EthStratumClient::handleResponse(int64_t id, const rapidjson::Value
     auto it = m_callbacks.find(id);
     if (it != m_callbacks.end()) {
         const uint64_t elapsed = Chrono::steadyMSecs() - it->second.ts;
+        addLatency(elapsed);
 
         if (error.IsArray() || error.IsObject() || error.IsString()) {
             it->second.callback(error, false, elapsed);
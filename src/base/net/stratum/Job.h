@@ -61,6 +61,7 @@ public:
     bool isEqual(const Job &other) const;
     bool isEqualBlob(const Job &other) const;
     bool setBlob(const char *blob);
+    bool setNextSeedHash(const char *hash);
     bool setSeedHash(const char *hash);
     bool setTarget(const char *target);
     void setDiff(uint64_t diff);
@@ -70,6 +71,7 @@ public:
     inline bool isValid() const                         { return (m_size > 0 && m_diff > 0) || !m_poolWallet.isEmpty(); }
     inline bool setId(const char *id)                   { return m_id = id; }
     inline const Algorithm &algorithm() const           { return m_algorithm; }
+    inline const Buffer &nextSeed() const               { return m_nextSeed; }
     inline const Buffer &seed() const                   { return m_seed; }
     inline const String &clientId() const               { return m_clientId; }
     inline const String &extraNonce() const             { return m_extraNonce; }
@@ -129,6 +131,7 @@ public:
     void generateSignatureData(String& signatureData, uint8_t& view_tag) const;
     void generateHashingBlob(String& blob) const;
 #   else
+    inline const uint8_t* ephPublicKey() const { return m_hasMinerSignature ? m_ephPublicKey : nullptr; }
     inline const uint8_t* ephSecretKey() const { return m_hasMinerSignature ? m_ephSecretKey : nullptr; }
 
     inline void setEphemeralKeys(const uint8_t *pub_key, const uint8_t *sec_key)
@@ -151,6 +154,7 @@ private:
 
     Algorithm m_algorithm;
     bool m_nicehash     = false;
+    Buffer m_nextSeed;
     Buffer m_seed;
     size_t m_size       = 0;
     String m_clientId;
@@ -0,0 +1,159 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "base/net/stratum/JobLatency.h"
+#include "base/tools/Chrono.h"
+
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+
+namespace xmrig {
+
+
+class JobLatencySamples
+{
+public:
+    inline JobLatencySamples() { m_data.reserve(kMaxSamples); }
+
+    inline void add(double value)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_data.size() < kMaxSamples) {
+            m_data.push_back(value);
+        }
+        else {
+            m_data[m_count % kMaxSamples] = value;
+        }
+
+        m_count++;
+        m_max = std::max(m_max, value);
+    }
+
+
+    inline void reset()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_data.clear();
+        m_count = 0;
+        m_max   = 0.0;
+    }
+
+
+    inline JobLatency::Summary summary()
+    {
+        JobLatency::Summary out;
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        auto data = m_data;
+        out.count = m_count;
+        out.max   = m_max;
+        lock.unlock();
+
+        if (data.empty()) {
+            return out;
+        }
+
+        std::sort(data.begin(), data.end());
+
+        out.p50 = percentile(data, 50);
+        out.p90 = percentile(data, 90);
+        out.p99 = percentile(data, 99);
+
+        return out;
+    }
+
+private:
+    static constexpr size_t kMaxSamples = 4096;
+
+    static inline double percentile(const std::vector<double> &sorted, size_t p)
+    {
+        return sorted[std::min(sorted.size() * p / 100, sorted.size() - 1)];
+    }
+
+    double m_max        = 0.0;
+    std::mutex m_mutex;
+    std::vector<double> m_data;
+    uint64_t m_count    = 0;
+};
+
+
+static JobLatencySamples samples[JobLatency::TYPE_MAX];
+static std::atomic<double> receivedTs{0.0};
+static std::atomic<int32_t> pending{0};
+static std::atomic<int32_t> workers{0};
+
+
+} // namespace xmrig
+
+
+xmrig::JobLatency::Summary xmrig::JobLatency::summary(Type type)
+{
+    return type < TYPE_MAX ? samples[type].summary() : Summary();
+}
+
+
+void xmrig::JobLatency::addWorker()
+{
+    workers.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+void xmrig::JobLatency::consumed()
+{
+    int32_t expected = pending.load(std::memory_order_relaxed);
+
+    while (expected > 0 && !pending.compare_exchange_weak(expected, expected - 1)) {}
+
+    // Only the last worker to pick up the job records the sample
+    if (expected == 1) {
+        samples[SWITCH].add(Chrono::highResolutionMSecs() - receivedTs.load());
+    }
+}
+
+
+void xmrig::JobLatency::received()
+{
+    receivedTs.store(Chrono::highResolutionMSecs());
+    pending.store(workers.load(std::memory_order_relaxed));
+}
+
+
+void xmrig::JobLatency::removeWorker()
+{
+    workers.fetch_sub(1, std::memory_order_relaxed);
+}
+
+
+void xmrig::JobLatency::reset()
+{
+    for (auto &s : samples) {
+        s.reset();
+    }
+}
+
+
+void xmrig::JobLatency::submitted(double elapsed)
+{
+    samples[SUBMIT].add(elapsed);
+}
@@ -0,0 +1,61 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef XMRIG_JOBLATENCY_H
+#define XMRIG_JOBLATENCY_H
+
+
+#include <cstdint>
+
+
+namespace xmrig {
+
+
+// Job pipeline latencies: from a job of the active pool until every CPU worker hashes the new blob
+// (job switch) and from a share submit until the pool response (submit round-trip), in milliseconds.
+class JobLatency
+{
+public:
+    enum Type : uint32_t {
+        SWITCH,
+        SUBMIT,
+        TYPE_MAX
+    };
+
+    struct Summary
+    {
+        uint64_t count  = 0;
+        double p50      = 0.0;
+        double p90      = 0.0;
+        double p99      = 0.0;
+        double max      = 0.0;
+    };
+
+    static Summary summary(Type type);
+    static void addWorker();
+    static void consumed();
+    static void received();
+    static void removeWorker();
+    static void reset();
+    static void submitted(double elapsed);
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_JOBLATENCY_H */
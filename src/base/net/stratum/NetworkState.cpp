@@ -18,12 +18,15 @@
 
 #include "base/net/stratum/NetworkState.h"
 #include "3rdparty/rapidjson/document.h"
+#include "base/api/Metrics.h"
 #include "base/io/log/Log.h"
 #include "base/kernel/interfaces/IClient.h"
 #include "base/kernel/interfaces/IStrategy.h"
 #include "base/net/stratum/Job.h"
+#include "base/net/stratum/JobLatency.h"
 #include "base/net/stratum/Pool.h"
 #include "base/net/stratum/SubmitResult.h"
+#include "base/net/tools/LineReader.h"
 #include "base/tools/Chrono.h"
 
 
@@ -137,6 +140,16 @@ rapidjson::Value xmrig::NetworkState::getConnection(rapidjson::Document &doc, in
     connection.AddMember("avg_time_ms",     avgTime(), allocator);
     connection.AddMember("hashes_total",    m_hashes, allocator);
 
+    const auto jobSwitch = JobLatency::summary(JobLatency::SWITCH);
+    Value latency(kObjectType);
+    latency.AddMember("count",  jobSwitch.count, allocator);
+    latency.AddMember("p50",    jobSwitch.p50, allocator);
+    latency.AddMember("p90",    jobSwitch.p90, allocator);
+    latency.AddMember("p99",    jobSwitch.p99, allocator);
+    latency.AddMember("max",    jobSwitch.max, allocator);
+
+    connection.AddMember("job_switch_ms", latency, allocator);
+
     if (version == 1) {
         connection.AddMember("error_log", Value(kArrayType), allocator);
     }
@@ -174,6 +187,55 @@ rapidjson::Value xmrig::NetworkState::getResults(rapidjson::Document &doc, int v
 
     return results;
 }
+
+
+void xmrig::NetworkState::getMetrics(Metrics &metrics) const
+{
+    const Metrics::Labels pool = { { "pool", m_pool } };
+
+    metrics.family("xmrig_pool_connected", Metrics::kGauge, "Connection to the active pool is up.");
+    metrics.add("xmrig_pool_connected", static_cast<uint64_t>(m_active), pool);
+
+    metrics.family("xmrig_pool_difficulty", Metrics::kGauge, "Difficulty of the current job.");
+    metrics.add("xmrig_pool_difficulty", m_diff, pool);
+
+    metrics.family("xmrig_pool_ping_seconds", Metrics::kGauge, "Median share response time of the current connection.", "seconds");
+    metrics.add("xmrig_pool_ping_seconds", static_cast<double>(latency()) / 1000.0, pool);
+
+    metrics.family("xmrig_pool_failures", Metrics::kCounter, "Pool connection failures.");
+    metrics.add("xmrig_pool_failures_total", m_failures);
+
+    metrics.family("xmrig_shares", Metrics::kCounter, "Shares answered by the pool.");
+    metrics.add("xmrig_shares_total", m_accepted, { { "result", "accepted" } });
+    metrics.add("xmrig_shares_total", m_rejected, { { "result", "rejected" } });
+
+    metrics.family("xmrig_hashes_accepted", Metrics::kCounter, "Sum of the difficulty of accepted shares.");
+    metrics.add("xmrig_hashes_accepted_total", m_hashes);
+
+    metrics.family("xmrig_stratum_bytes", Metrics::kCounter, "Stratum bytes of all connections since start, parsed in place or copied to assemble split lines.", "bytes");
+    metrics.add("xmrig_stratum_bytes_total", LineReader::totalParsed(), { { "mode", "parsed" } });
+    metrics.add("xmrig_stratum_bytes_total", LineReader::totalCopied(), { { "mode", "copied" } });
+
+    static const char *names[JobLatency::TYPE_MAX][2] = {
+        { "xmrig_job_switch_seconds", "Time from job arrival until the last worker picked it up." },
+        { "xmrig_submit_rtt_seconds", "Share submit round trip time." }
+    };
+
+    char name[64];
+
+    for (uint32_t type = 0; type < JobLatency::TYPE_MAX; ++type) {
+        const auto summary = JobLatency::summary(static_cast<JobLatency::Type>(type));
+
+        metrics.family(names[type][0], Metrics::kSummary, names[type][1], "seconds");
+        metrics.add(names[type][0], summary.p50 / 1000.0, { { "quantile", "0.5" } });
+        metrics.add(names[type][0], summary.p90 / 1000.0, { { "quantile", "0.9" } });
+        metrics.add(names[type][0], summary.p99 / 1000.0, { { "quantile", "0.99" } });
+        metrics.add(names[type][0], summary.max / 1000.0, { { "quantile", "1" } });
+
+        snprintf(name, sizeof(name), "%s_count", names[type][0]);
+        metrics.add(name, summary.count);
+    }
+}
 #endif
 
 
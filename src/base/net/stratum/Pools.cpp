@@ -32,6 +32,9 @@
 #include "donate.h"
 
 
+#include <algorithm>
+
+
 #ifdef XMRIG_FEATURE_BENCHMARK
 #   include "base/net/stratum/benchmark/BenchConfig.h"
 #endif
@@ -42,9 +45,16 @@ namespace xmrig {
 
 const char *Pools::kDonateLevel     = "donate-level";
 const char *Pools::kDonateOverProxy = "donate-over-proxy";
+const char *Pools::kHotStandby      = "hot-standby";
+const char *Pools::kMaxLineSize     = "max-line-size";
 const char *Pools::kPools           = "pools";
 const char *Pools::kRetries         = "retries";
 const char *Pools::kRetryPause      = "retry-pause";
+const char *Pools::kSubmitInflight  = "submit-inflight";
+const char *Pools::kSubmitWindow    = "submit-window";
+const char *Pools::kSwitchJobTimeout = "switch-job-timeout";
+const char *Pools::kSwitchLatency   = "switch-latency";
+const char *Pools::kSwitchRejectRate = "switch-reject-rate";
 
 
 } // namespace xmrig
@@ -62,7 +72,9 @@ xmrig::Pools::Pools() :
 
 bool xmrig::Pools::isEqual(const Pools &other) const
 {
-    if (m_data.size() != other.m_data.size() || m_retries != other.m_retries || m_retryPause != other.m_retryPause) {
+    if (m_data.size() != other.m_data.size() || m_retries != other.m_retries || m_retryPause != other.m_retryPause ||
+        m_hotStandby != other.m_hotStandby || m_switchLatency != other.m_switchLatency || m_switchRejectRate != other.m_switchRejectRate ||
+        m_switchJobTimeout != other.m_switchJobTimeout) {
         return false;
     }
 
@@ -91,6 +103,10 @@ xmrig::IStrategy *xmrig::Pools::createStrategy(IStrategyListener *listener) cons
     }
 
     auto strategy = new FailoverStrategy(retryPause(), retries(), listener);
+    if (m_hotStandby) {
+        strategy->setHotStandby(m_switchLatency, m_switchRejectRate, m_switchJobTimeout);
+    }
+
     for (const Pool &pool : m_data) {
         if (pool.isEnabled()) {
             strategy->add(pool);
@@ -162,6 +178,15 @@ void xmrig::Pools::load(const IJsonReader &reader)
     setProxyDonate(reader.getInt(kDonateOverProxy, PROXY_DONATE_AUTO));
     setRetries(reader.getInt(kRetries));
     setRetryPause(reader.getInt(kRetryPause));
+    setMaxLineSize(reader.getUint64(kMaxLineSize));
+
+    m_submitInflight = std::min(reader.getUint(kSubmitInflight, m_submitInflight), 1024U);
+    m_submitWindow   = std::min(reader.getUint(kSubmitWindow, m_submitWindow), 100U);
+
+    m_hotStandby        = reader.getBool(kHotStandby, m_hotStandby);
+    m_switchLatency     = reader.getUint(kSwitchLatency, m_switchLatency);
+    m_switchRejectRate  = std::min(reader.getUint(kSwitchRejectRate, m_switchRejectRate), 100U);
+    m_switchJobTimeout  = reader.getUint(kSwitchJobTimeout, m_switchJobTimeout);
 }
 
 
@@ -212,6 +237,13 @@ void xmrig::Pools::toJSON(rapidjson::Value &out, rapidjson::Document &doc) const
     out.AddMember(StringRef(kPools),            toJSON(doc), allocator);
     doc.AddMember(StringRef(kRetries),          retries(), allocator);
     doc.AddMember(StringRef(kRetryPause),       retryPause(), allocator);
+    doc.AddMember(StringRef(kMaxLineSize),      static_cast<uint64_t>(m_maxLineSize), allocator);
+    doc.AddMember(StringRef(kSubmitWindow),     m_submitWindow, allocator);
+    doc.AddMember(StringRef(kSubmitInflight),   m_submitInflight, allocator);
+    doc.AddMember(StringRef(kHotStandby),       m_hotStandby, allocator);
+    doc.AddMember(StringRef(kSwitchLatency),    m_switchLatency, allocator);
+    doc.AddMember(StringRef(kSwitchRejectRate), m_switchRejectRate, allocator);
+    doc.AddMember(StringRef(kSwitchJobTimeout), m_switchJobTimeout, allocator);
 }
 
 
@@ -223,6 +255,14 @@ void xmrig::Pools::setDonateLevel(int level)
 }
 
 
+void xmrig::Pools::setMaxLineSize(uint64_t size)
+{
+    if (size >= XMRIG_NET_BUFFER_CHUNK_SIZE && size <= 256 * 1024 * 1024) {
+        m_maxLineSize = static_cast<size_t>(size);
+    }
+}
+
+
 void xmrig::Pools::setProxyDonate(int value)
 {
     switch (value) {
@@ -29,6 +29,7 @@
 #include <vector>
 
 
+#include "base/kernel/constants.h"
 #include "base/net/stratum/Pool.h"
 
 
@@ -45,9 +46,16 @@ class Pools
 public:
     static const char *kDonateLevel;
     static const char *kDonateOverProxy;
+    static const char *kHotStandby;
+    static const char *kMaxLineSize;
     static const char *kPools;
     static const char *kRetries;
     static const char *kRetryPause;
+    static const char *kSubmitInflight;
+    static const char *kSubmitWindow;
+    static const char *kSwitchJobTimeout;
+    static const char *kSwitchLatency;
+    static const char *kSwitchRejectRate;
 
     enum ProxyDonate {
         PROXY_DONATE_NONE,
@@ -63,9 +71,16 @@ public:
     inline constexpr static bool isBenchmark()          { return false; }
 #   endif
 
+    inline bool isHotStandby() const                    { return m_hotStandby; }
     inline const std::vector<Pool> &data() const        { return m_data; }
     inline int retries() const                          { return m_retries; }
     inline int retryPause() const                       { return m_retryPause; }
+    inline size_t maxLineSize() const                   { return m_maxLineSize; }
+    inline uint32_t submitInflight() const              { return m_submitInflight; }
+    inline uint32_t submitWindow() const                { return m_submitWindow; }
+    inline uint32_t switchLatency() const               { return m_switchLatency; }
+    inline uint32_t switchRejectRate() const            { return m_switchRejectRate; }
+    inline uint32_t switchJobTimeout() const            { return m_switchJobTimeout; }
     inline ProxyDonate proxyDonate() const              { return m_proxyDonate; }
 
     inline bool operator!=(const Pools &other) const    { return !isEqual(other); }
@@ -83,14 +98,22 @@ public:
 
 private:
     void setDonateLevel(int level);
+    void setMaxLineSize(uint64_t size);
     void setProxyDonate(int value);
     void setRetries(int retries);
     void setRetryPause(int retryPause);
 
+    bool m_hotStandby          = false;
     int m_donateLevel;
     int m_retries               = 5;
     int m_retryPause            = 5;
     ProxyDonate m_proxyDonate   = PROXY_DONATE_AUTO;
+    size_t m_maxLineSize        = XMRIG_NET_MAX_LINE_SIZE;
+    uint32_t m_submitInflight   = 0;
+    uint32_t m_submitWindow     = 0;
+    uint32_t m_switchLatency    = 0;
+    uint32_t m_switchRejectRate = 0;
+    uint32_t m_switchJobTimeout = 600;
     std::vector<Pool> m_data;
 
 #   ifdef XMRIG_FEATURE_BENCHMARK
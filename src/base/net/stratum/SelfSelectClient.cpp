@@ -152,6 +152,7 @@ bool xmrig::SelfSelectClient::parseResponse(int64_t id, rapidjson::Value &result
 
     m_job.setHeight(Json::getUint64(result, kHeight));
     m_job.setSeedHash(Json::getString(result, kSeedHash));
+    m_job.setNextSeedHash(Json::getString(result, kNextSeedHash));
 
     submitBlockTemplate(result);
 
@@ -174,6 +175,8 @@ void xmrig::SelfSelectClient::getBlockTemplate()
     JsonRequest::create(doc, m_sequence++, "getblocktemplate", params);
 
     FetchRequest req(HTTP_POST, pool().daemon().host(), pool().daemon().port(), "/json_rpc", doc, pool().daemon().isTLS(), isQuiet());
+    req.keepAlive = true;
+
     fetch(tag(), std::move(req), m_httpListener);
 }
 
@@ -286,6 +289,8 @@ void xmrig::SelfSelectClient::submitOriginDaemon(const JobResult& result)
     m_results[m_sequence] = SubmitResult(m_sequence, result.diff, result.actualDiff(), 0, result.backend);
 
     FetchRequest req(HTTP_POST, pool().daemon().host(), pool().daemon().port(), "/json_rpc", doc, pool().daemon().isTLS(), isQuiet());
+    req.keepAlive = true;
+
     fetch(tag(), std::move(req), m_httpListener);
 
     m_originSubmitted++;
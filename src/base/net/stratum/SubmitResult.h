@@ -43,10 +43,15 @@ public:
         backend(backend),
         actualDiff(actualDiff),
         diff(diff),
-        m_start(Chrono::steadyMSecs())
+        m_start(Chrono::steadyMSecs()),
+        m_startHr(Chrono::highResolutionMSecs())
     {}
 
-    inline void done() { elapsed = Chrono::steadyMSecs() - m_start; }
+    inline void done()
+    {
+        elapsed = Chrono::steadyMSecs() - m_start;
+        latency = Chrono::highResolutionMSecs() - m_startHr;
+    }
 
     int64_t reqId           = 0;
     int64_t seq             = 0;
@@ -54,9 +59,11 @@ public:
     uint64_t actualDiff     = 0;
     uint64_t diff           = 0;
     uint64_t elapsed        = 0;
+    double latency          = 0.0;
 
 private:
     uint64_t m_start        = 0;
+    double m_startHr        = 0.0;
 };
 
 
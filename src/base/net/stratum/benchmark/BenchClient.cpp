@@ -32,6 +32,7 @@
 #include "base/net/http/HttpData.h"
 #include "base/net/http/HttpListener.h"
 #include "base/net/stratum/benchmark/BenchConfig.h"
+#include "base/tools/cryptonote/Signatures.h"
 #include "base/tools/Cvt.h"
 #include "version.h"
 
@@ -116,6 +117,15 @@ xmrig::BenchClient::BenchClient(const std::shared_ptr<BenchConfig> &benchmark, I
         return;
     }
 
+    // Sign every hash with a throwaway key, the same work a miner does for pools and daemons with miner signatures.
+    if (m_benchmark->isSignature() && (m_benchmark->algorithm().family() == Algorithm::RANDOM_X)) {
+        uint8_t pub[32];
+        uint8_t sec[32];
+        generate_keys(pub, sec);
+
+        m_job.setEphemeralKeys(pub, sec);
+    }
+
     m_job.setBenchSize(m_benchmark->size());
 
 }
@@ -279,6 +289,11 @@ uint64_t xmrig::BenchClient::referenceHash() const
         return m_hash;
     }
 
+    // Signatures use random nonces, so the hash sum is different on every run
+    if (m_job.hasMinerSignature()) {
+        return 0;
+    }
+
     return BenchState::referenceHash(m_job.algorithm(), BenchState::size(), m_threads);
 }
 
@@ -52,6 +52,7 @@ public:
     inline int64_t send(const rapidjson::Value &) override                          { return 0; }
     inline int64_t sequence() const override                                        { return 0; }
     inline int64_t submit(const JobResult &) override                               { return 0; }
+    inline uint64_t latency() const override                                        { return 0; }
     inline void connect(const Pool &pool) override                                  { setPool(pool); }
     inline void deleteLater() override                                              { delete this; }
     inline void setAlgo(const Algorithm &algo) override                             {}
@@ -38,6 +38,7 @@ const char *BenchConfig::kBenchmark = "benchmark";
 const char *BenchConfig::kHash      = "hash";
 const char *BenchConfig::kId        = "id";
 const char *BenchConfig::kSeed      = "seed";
+const char *BenchConfig::kSignature = "signature";
 const char *BenchConfig::kSize      = "size";
 const char *BenchConfig::kRotation  = "rotation";
 const char *BenchConfig::kSubmit    = "submit";
@@ -57,6 +58,7 @@ const char *BenchConfig::kApiHost   = "127.0.0.1";
 xmrig::BenchConfig::BenchConfig(uint32_t size, const String &id, const rapidjson::Value &object, bool dmi, uint32_t rotation) :
     m_algorithm(Json::getString(object, kAlgo)),
     m_dmi(dmi),
+    m_signature(Json::getBool(object, kSignature)),
     m_submit(Json::getBool(object, kSubmit)),
     m_id(id),
     m_seed(Json::getString(object, kSeed)),
@@ -123,6 +125,7 @@ rapidjson::Value xmrig::BenchConfig::toJSON(rapidjson::Document &doc) const
     out.AddMember(StringRef(kToken),    m_token.toJSON(), allocator);
     out.AddMember(StringRef(kSeed),     m_seed.toJSON(), allocator);
     out.AddMember(StringRef(kUser),     m_user.toJSON(), allocator);
+    out.AddMember(StringRef(kSignature), m_signature, allocator);
 
     if (m_hash) {
         out.AddMember(StringRef(kHash), Value(fmt::format("{:016X}", m_hash).c_str(), allocator), allocator);
@@ -36,6 +36,7 @@ public:
     static const char *kHash;
     static const char *kId;
     static const char *kSeed;
+    static const char *kSignature;
     static const char *kSize;
     static const char* kRotation;
     static const char *kSubmit;
@@ -56,6 +57,7 @@ public:
     static BenchConfig *create(const rapidjson::Value &object, bool dmi);
 
     inline bool isDMI() const                   { return m_dmi; }
+    inline bool isSignature() const             { return m_signature; }
     inline bool isSubmit() const                { return m_submit; }
     inline const Algorithm &algorithm() const   { return m_algorithm; }
     inline const String &id() const             { return m_id; }
@@ -73,6 +75,7 @@ private:
 
     Algorithm m_algorithm;
     bool m_dmi;
+    bool m_signature;
     bool m_submit;
     String m_id;
     String m_seed;
@@ -0,0 +1,546 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "base/net/stratum/emulator/Emulator.h"
+#include "3rdparty/rapidjson/document.h"
+#include "3rdparty/rapidjson/error/en.h"
+#include "3rdparty/rapidjson/stringbuffer.h"
+#include "3rdparty/rapidjson/writer.h"
+#include "base/io/json/Json.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "base/kernel/interfaces/ILineListener.h"
+#include "base/net/stratum/emulator/EmulatorConfig.h"
+#include "base/net/stratum/JobLatency.h"
+#include "base/net/tools/LineReader.h"
+#include "base/net/tools/NetBuffer.h"
+#include "base/net/tools/TcpServer.h"
+#include "base/tools/Baton.h"
+#include "base/tools/Cvt.h"
+#include "base/tools/Timer.h"
+
+
+#include <cinttypes>
+#include <cstring>
+#include <fstream>
+#include <set>
+#include <string>
+#include <uv.h>
+#include <vector>
+
+
+namespace xmrig {
+
+
+static const char *kJob         = "job";
+static const char *kJobId       = "job_id";
+static const char *kMethod      = "method";
+static const char *kParams      = "params";
+static constexpr size_t kBlobSize      = 76;
+static constexpr size_t kNonceOffset   = 39;
+
+
+class EmulatorConnection;
+
+
+class EmulatorWriteBaton : public Baton<uv_write_t>
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(EmulatorWriteBaton)
+
+    inline explicit EmulatorWriteBaton(std::string &&data) :
+        m_data(std::move(data))
+    {
+        m_buf = uv_buf_init(&m_data.front(), m_data.size());
+    }
+
+    void write(uv_stream_t *stream)
+    {
+        uv_write(&req, stream, &m_buf, 1, [](uv_write_t *req, int) { delete reinterpret_cast<EmulatorWriteBaton *>(req->data); });
+    }
+
+private:
+    std::string m_data;
+    uv_buf_t m_buf{};
+};
+
+
+class EmulatorPrivate
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(EmulatorPrivate)
+
+    inline explicit EmulatorPrivate(const EmulatorConfig &config) : config(config) {}
+
+    bool loadJobs();
+    void broadcast();
+    void onRequest(EmulatorConnection *connection, const rapidjson::Document &doc);
+    void nextJob();
+    void print(bool final) const;
+
+    const EmulatorConfig config;
+    rapidjson::Document current;
+    std::set<EmulatorConnection *> connections;
+    std::string currentId;
+    std::vector<rapidjson::Document> jobs;
+    String seed;
+    Timer *jobTimer             = nullptr;
+    Timer *reportTimer          = nullptr;
+    TcpServer *server           = nullptr;
+    uint64_t accepted           = 0;
+    uint64_t broadcasts         = 0;
+    uint64_t height             = 0;
+    uint64_t sequence           = 0;
+    uint64_t stale              = 0;
+    uint64_t totalConnections   = 0;
+
+private:
+    void addJob(const rapidjson::Value &value);
+};
+
+
+class EmulatorConnection : public ILineListener
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(EmulatorConnection)
+
+    inline EmulatorConnection(EmulatorPrivate *owner, uint64_t id) :
+        m_id(std::to_string(id)),
+        m_owner(owner)
+    {
+        m_reader.setListener(this);
+
+        uv_tcp_init(uv_default_loop(), &m_tcp);
+        uv_tcp_nodelay(&m_tcp, 1);
+
+        m_tcp.data = this;
+    }
+
+    inline const std::string &id() const    { return m_id; }
+    inline uv_stream_t *stream()            { return reinterpret_cast<uv_stream_t *>(&m_tcp); }
+    inline void detach()                    { m_owner = nullptr; }
+
+    void close()
+    {
+        if (m_owner) {
+            m_owner->connections.erase(this);
+            m_owner = nullptr;
+        }
+
+        if (uv_is_closing(reinterpret_cast<uv_handle_t *>(&m_tcp))) {
+            return;
+        }
+
+        uv_close(reinterpret_cast<uv_handle_t *>(&m_tcp), [](uv_handle_t *handle) { delete static_cast<EmulatorConnection *>(handle->data); });
+    }
+
+    void read()
+    {
+        uv_read_start(stream(), NetBuffer::onAlloc, [](uv_stream_t *tcp, ssize_t nread, const uv_buf_t *buf)
+        {
+            auto connection = static_cast<EmulatorConnection *>(tcp->data);
+
+            if (nread == 0) {
+                NetBuffer::release(buf);
+
+                return;
+            }
+
+            if (nread < 0 || !connection->m_reader.parse(buf->base, static_cast<size_t>(nread))) {
+                connection->close();
+            }
+
+            NetBuffer::release(buf);
+        });
+    }
+
+    void send(const rapidjson::Document &doc)
+    {
+        if (uv_is_writable(stream()) != 1) {
+            return;
+        }
+
+        using namespace rapidjson;
+
+        StringBuffer buffer(nullptr, 512);
+        Writer<StringBuffer> writer(buffer);
+        doc.Accept(writer);
+
+        std::string data(buffer.GetString(), buffer.GetSize());
+        data += '\n';
+
+        auto baton = new EmulatorWriteBaton(std::move(data));
+        baton->write(stream());
+    }
+
+protected:
+    void onLine(char *line, size_t size) override
+    {
+        if (!m_owner) {
+            return;
+        }
+
+        rapidjson::Document doc;
+        if (doc.Parse(line, size).HasParseError() || !doc.IsObject()) {
+            LOG_WARN("%s " YELLOW("invalid request from miner #%s: \"%s\""), Tags::emulator(), m_id.c_str(), rapidjson::GetParseError_En(doc.GetParseError()));
+
+            return close();
+        }
+
+        m_owner->onRequest(this, doc);
+    }
+
+private:
+    const std::string m_id;
+    EmulatorPrivate *m_owner;
+    LineReader m_reader;
+    uv_tcp_t m_tcp{};
+};
+
+
+} // namespace xmrig
+
+
+bool xmrig::EmulatorPrivate::loadJobs()
+{
+    jobs.clear();
+
+    if (config.jobs().isEmpty()) {
+        return true;
+    }
+
+    std::ifstream in(config.jobs().data());
+    if (!in.is_open()) {
+        LOG_ERR("%s " RED("failed to open job stream \"%s\""), Tags::emulator(), config.jobs().data());
+
+        return false;
+    }
+
+    std::string line;
+    size_t lineNumber = 0;
+
+    while (std::getline(in, line)) {
+        ++lineNumber;
+
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        rapidjson::Document doc;
+        if (doc.Parse(line.c_str(), line.size()).HasParseError() || !doc.IsObject()) {
+            LOG_WARN("%s " YELLOW("%s:%zu: invalid JSON, line skipped"), Tags::emulator(), config.jobs().data(), lineNumber);
+
+            continue;
+        }
+
+        // Recorded pool traffic ({"method":"job","params":{...}}), login results ({"job":{...}}) and plain job objects are accepted.
+        if (doc.HasMember(kParams) && doc.HasMember(kMethod)) {
+            addJob(doc[kParams]);
+        }
+        else if (doc.HasMember(kJob)) {
+            addJob(doc[kJob]);
+        }
+        else {
+            addJob(doc);
+        }
+    }
+
+    if (jobs.empty()) {
+        LOG_ERR("%s " RED("job stream \"%s\" contains no jobs"), Tags::emulator(), config.jobs().data());
+
+        return false;
+    }
+
+    return true;
+}
+
+
+void xmrig::EmulatorPrivate::broadcast()
+{
+    nextJob();
+
+    rapidjson::Document doc(rapidjson::kObjectType);
+    auto &allocator = doc.GetAllocator();
+
+    doc.AddMember("jsonrpc", "2.0", allocator);
+    doc.AddMember(rapidjson::StringRef(kMethod), rapidjson::StringRef(kJob), allocator);
+    doc.AddMember(rapidjson::StringRef(kParams), rapidjson::Value(current, allocator), allocator);
+
+    auto &params = doc[kParams];
+    params.AddMember("id", "", allocator);
+
+    for (auto connection : connections) {
+        params["id"].SetString(connection->id().c_str(), allocator);
+        connection->send(doc);
+    }
+}
+
+
+void xmrig::EmulatorPrivate::onRequest(EmulatorConnection *connection, const rapidjson::Document &doc)
+{
+    using namespace rapidjson;
+
+    const char *method = Json::getString(doc, kMethod, "");
+
+    Document reply(kObjectType);
+    auto &allocator = reply.GetAllocator();
+
+    reply.AddMember("id", Json::getInt64(doc, "id"), allocator);
+    reply.AddMember("jsonrpc", "2.0", allocator);
+
+    if (strcmp(method, "login") == 0) {
+        Value job(current, allocator);
+        job.AddMember("id", Value(connection->id().c_str(), allocator), allocator);
+
+        Value result(kObjectType);
+        result.AddMember("id", Value(connection->id().c_str(), allocator), allocator);
+        result.AddMember(StringRef(kJob), job, allocator);
+        result.AddMember("status", "OK", allocator);
+
+        reply.AddMember("error", Value(kNullType), allocator);
+        reply.AddMember("result", result, allocator);
+    }
+    else if (strcmp(method, "submit") == 0 || strcmp(method, "keepalived") == 0) {
+        const auto &params = Json::getObject(doc, kParams);
+        bool ok            = true;
+
+        if (strcmp(method, "submit") == 0) {
+            if (currentId == Json::getString(params, kJobId, "")) {
+                ++accepted;
+            }
+            else {
+                ++stale;
+                ok = false;
+            }
+        }
+
+        if (ok) {
+            Value result(kObjectType);
+            result.AddMember("status", "OK", allocator);
+
+            reply.AddMember("error", Value(kNullType), allocator);
+            reply.AddMember("result", result, allocator);
+        }
+        else {
+            Value error(kObjectType);
+            error.AddMember("code", -1, allocator);
+            error.AddMember("message", "Block expired", allocator);
+
+            reply.AddMember("error", error, allocator);
+        }
+    }
+    else {
+        Value error(kObjectType);
+        error.AddMember("code", -1, allocator);
+        error.AddMember("message", "Unsupported method", allocator);
+
+        reply.AddMember("error", error, allocator);
+    }
+
+    connection->send(reply);
+}
+
+
+void xmrig::EmulatorPrivate::print(bool final) const
+{
+    const auto switchLatency = JobLatency::summary(JobLatency::SWITCH);
+    const auto submitLatency = JobLatency::summary(JobLatency::SUBMIT);
+    const uint64_t shares    = accepted + stale;
+
+    LOG_INFO("%s " WHITE_BOLD("%s") " jobs " CYAN_BOLD("%" PRIu64) " miners " CYAN_BOLD("%zu/%" PRIu64) " shares " CYAN_BOLD("%" PRIu64) " stale " CYAN_BOLD("%" PRIu64) " (%.2f%%)",
+             Tags::emulator(),
+             final ? "summary" : "report",
+             broadcasts,
+             connections.size(),
+             totalConnections,
+             shares,
+             stale,
+             shares ? static_cast<double>(stale) * 100.0 / static_cast<double>(shares) : 0.0
+             );
+
+    LOG_INFO("%s job switch " CYAN_BOLD("%" PRIu64) " p50/p90/p99/max " WHITE_BOLD("%.2f/%.2f/%.2f/%.2f") " ms",
+             Tags::emulator(), switchLatency.count, switchLatency.p50, switchLatency.p90, switchLatency.p99, switchLatency.max);
+
+    LOG_INFO("%s submit RTT " CYAN_BOLD("%" PRIu64) " p50/p90/p99/max " WHITE_BOLD("%.2f/%.2f/%.2f/%.2f") " ms",
+             Tags::emulator(), submitLatency.count, submitLatency.p50, submitLatency.p90, submitLatency.p99, submitLatency.max);
+}
+
+
+void xmrig::EmulatorPrivate::addJob(const rapidjson::Value &value)
+{
+    if (!value.IsObject() || !value.HasMember("blob") || !value.HasMember("target")) {
+        return;
+    }
+
+    rapidjson::Document job(rapidjson::kObjectType);
+    job.CopyFrom(value, job.GetAllocator());
+    job.RemoveMember("id");
+
+    jobs.emplace_back(std::move(job));
+}
+
+
+void xmrig::EmulatorPrivate::nextJob()
+{
+    using namespace rapidjson;
+
+    currentId = std::to_string(++sequence);
+    ++broadcasts;
+
+    current.SetObject();
+    auto &allocator = current.GetAllocator();
+
+    if (!jobs.empty()) {
+        current.CopyFrom(jobs[(sequence - 1) % jobs.size()], allocator);
+        current.RemoveMember(kJobId);
+        current.AddMember(StringRef(kJobId), Value(currentId.c_str(), allocator), allocator);
+
+        return;
+    }
+
+    uint8_t blob[kBlobSize];
+    Cvt::randomBytes(blob, sizeof(blob));
+    memset(blob + kNonceOffset, 0, 4);
+
+    const uint64_t target = 0xFFFFFFFFFFFFFFFFULL / config.diff();
+
+    current.AddMember("blob",   Cvt::toHex(blob, sizeof(blob), current), allocator);
+    current.AddMember(StringRef(kJobId), Value(currentId.c_str(), allocator), allocator);
+    current.AddMember("target", Cvt::toHex(reinterpret_cast<const uint8_t *>(&target), sizeof(target), current), allocator);
+    current.AddMember("algo",   config.algorithm().toJSON(), allocator);
+    current.AddMember("height", ++height, allocator);
+
+    if (config.algorithm().family() == Algorithm::RANDOM_X) {
+        current.AddMember("seed_hash", seed.toJSON(), allocator);
+    }
+}
+
+
+xmrig::Emulator::Emulator(const EmulatorConfig &config) :
+    d_ptr(new EmulatorPrivate(config))
+{
+}
+
+
+xmrig::Emulator::~Emulator()
+{
+    stop();
+
+    delete d_ptr;
+}
+
+
+bool xmrig::Emulator::start()
+{
+    if (!d_ptr->loadJobs()) {
+        return false;
+    }
+
+    const auto &config = d_ptr->config;
+    if (config.seed().size() == 64) {
+        d_ptr->seed = config.seed();
+    }
+    else {
+        uint8_t seed[32];
+        Cvt::randomBytes(seed, sizeof(seed));
+
+        d_ptr->seed = Cvt::toHex(seed, sizeof(seed));
+    }
+
+    d_ptr->server = new TcpServer(config.host(), config.port(), this);
+
+    const int rc = d_ptr->server->bind();
+    Log::print(GREEN_BOLD(" * ") WHITE_BOLD("%-13s") CYAN_BOLD("%s:%d") " " RED_BOLD("%s"),
+               "EMULATOR",
+               config.host().data(),
+               rc < 0 ? config.port() : rc,
+               rc < 0 ? uv_strerror(rc) : ""
+               );
+
+    if (rc < 0) {
+        stop();
+
+        return false;
+    }
+
+    LOG_INFO("%s " WHITE_BOLD("%s") " jobs every " CYAN_BOLD("%" PRIu64 " ms") " algo " WHITE_BOLD("%s") " diff " WHITE_BOLD("%" PRIu64),
+             Tags::emulator(),
+             d_ptr->jobs.empty() ? "synthetic" : config.jobs().data(),
+             config.interval(),
+             config.algorithm().name(),
+             config.diff()
+             );
+
+    JobLatency::reset();
+    d_ptr->nextJob();
+
+    d_ptr->jobTimer = new Timer(this, config.interval(), config.interval());
+
+    if (config.report()) {
+        d_ptr->reportTimer = new Timer(this, config.report() * 1000, config.report() * 1000);
+    }
+
+    return true;
+}
+
+
+void xmrig::Emulator::stop()
+{
+    if (d_ptr->jobTimer) {
+        d_ptr->print(true);
+    }
+
+    delete d_ptr->jobTimer;
+    delete d_ptr->reportTimer;
+    delete d_ptr->server;
+
+    d_ptr->jobTimer    = nullptr;
+    d_ptr->reportTimer = nullptr;
+    d_ptr->server      = nullptr;
+
+    auto connections = d_ptr->connections;
+    for (auto connection : connections) {
+        connection->close();
+    }
+}
+
+
+void xmrig::Emulator::onConnection(uv_stream_t *stream, uint16_t)
+{
+    auto connection = new EmulatorConnection(d_ptr, ++d_ptr->totalConnections);
+    if (uv_accept(stream, connection->stream()) < 0) {
+        connection->detach();
+
+        return connection->close();
+    }
+
+    d_ptr->connections.insert(connection);
+    connection->read();
+}
+
+
+void xmrig::Emulator::onTimer(const Timer *timer)
+{
+    if (timer == d_ptr->jobTimer) {
+        d_ptr->broadcast();
+    }
+    else {
+        d_ptr->print(false);
+    }
+}
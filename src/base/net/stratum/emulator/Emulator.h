@@ -0,0 +1,61 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef XMRIG_EMULATOR_H
+#define XMRIG_EMULATOR_H
+
+
+#include "base/kernel/interfaces/ITcpServerListener.h"
+#include "base/kernel/interfaces/ITimerListener.h"
+#include "base/tools/Object.h"
+
+
+namespace xmrig {
+
+
+class EmulatorConfig;
+class EmulatorPrivate;
+
+
+// Minimal local stratum pool for developers: replays recorded (or synthetic) jobs at a fixed
+// rate, counts stale shares and periodically reports job switch and submit latency percentiles.
+class Emulator : public ITcpServerListener, public ITimerListener
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(Emulator)
+
+    Emulator(const EmulatorConfig &config);
+    ~Emulator() override;
+
+    bool start();
+    void stop();
+
+protected:
+    void onConnection(uv_stream_t *stream, uint16_t port) override;
+    void onTimer(const Timer *timer) override;
+
+private:
+    EmulatorPrivate *d_ptr;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_EMULATOR_H */
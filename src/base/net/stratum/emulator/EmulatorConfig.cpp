@@ -0,0 +1,95 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "base/net/stratum/emulator/EmulatorConfig.h"
+#include "3rdparty/rapidjson/document.h"
+#include "base/io/json/Json.h"
+
+
+namespace xmrig {
+
+
+const char *EmulatorConfig::kAlgo       = "algo";
+const char *EmulatorConfig::kDiff       = "diff";
+const char *EmulatorConfig::kEnabled    = "enabled";
+const char *EmulatorConfig::kField      = "emulator";
+const char *EmulatorConfig::kHost       = "host";
+const char *EmulatorConfig::kInterval   = "interval";
+const char *EmulatorConfig::kJobs       = "jobs";
+const char *EmulatorConfig::kPort       = "port";
+const char *EmulatorConfig::kReport     = "report";
+const char *EmulatorConfig::kSeed       = "seed";
+
+
+static const char *kLocalhost           = "127.0.0.1";
+
+
+} // namespace xmrig
+
+
+xmrig::EmulatorConfig::EmulatorConfig() :
+    m_host(kLocalhost)
+{
+}
+
+
+rapidjson::Value xmrig::EmulatorConfig::toJSON(rapidjson::Document &doc) const
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    Value obj(kObjectType);
+
+    obj.AddMember(StringRef(kEnabled),  m_enabled, allocator);
+    obj.AddMember(StringRef(kHost),     m_host.toJSON(), allocator);
+    obj.AddMember(StringRef(kPort),     m_port, allocator);
+    obj.AddMember(StringRef(kAlgo),     m_algorithm.toJSON(), allocator);
+    obj.AddMember(StringRef(kDiff),     m_diff, allocator);
+    obj.AddMember(StringRef(kSeed),     m_seed.toJSON(), allocator);
+    obj.AddMember(StringRef(kJobs),     m_jobs.toJSON(), allocator);
+    obj.AddMember(StringRef(kInterval), m_interval, allocator);
+    obj.AddMember(StringRef(kReport),   m_report, allocator);
+
+    return obj;
+}
+
+
+void xmrig::EmulatorConfig::load(const rapidjson::Value &value)
+{
+    if (!value.IsObject()) {
+        return;
+    }
+
+    m_enabled   = Json::getBool(value, kEnabled);
+    m_host      = Json::getString(value, kHost, kLocalhost);
+    m_jobs      = Json::getString(value, kJobs);
+    m_seed      = Json::getString(value, kSeed);
+    m_diff      = std::max<uint64_t>(Json::getUint64(value, kDiff, m_diff), 1);
+    m_interval  = std::max<uint64_t>(Json::getUint64(value, kInterval, m_interval), 10);
+    m_report    = Json::getUint64(value, kReport, m_report);
+
+    const Algorithm algorithm(Json::getString(value, kAlgo));
+    if (algorithm.isValid()) {
+        m_algorithm = algorithm;
+    }
+
+    const int port = Json::getInt(value, kPort, m_port);
+    if (port > 0 && port <= 65535) {
+        m_port = static_cast<uint16_t>(port);
+    }
+}
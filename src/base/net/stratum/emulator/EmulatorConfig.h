@@ -0,0 +1,75 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef XMRIG_EMULATORCONFIG_H
+#define XMRIG_EMULATORCONFIG_H
+
+
+#include "3rdparty/rapidjson/fwd.h"
+#include "base/crypto/Algorithm.h"
+#include "base/tools/String.h"
+
+
+namespace xmrig {
+
+
+class EmulatorConfig
+{
+public:
+    static const char *kAlgo;
+    static const char *kDiff;
+    static const char *kEnabled;
+    static const char *kField;
+    static const char *kHost;
+    static const char *kInterval;
+    static const char *kJobs;
+    static const char *kPort;
+    static const char *kReport;
+    static const char *kSeed;
+
+    EmulatorConfig();
+
+    inline bool isEnabled() const               { return m_enabled; }
+    inline const Algorithm &algorithm() const   { return m_algorithm; }
+    inline const String &host() const           { return m_host; }
+    inline const String &jobs() const           { return m_jobs; }
+    inline const String &seed() const           { return m_seed; }
+    inline uint16_t port() const                { return m_port; }
+    inline uint64_t diff() const                { return m_diff; }
+    inline uint64_t interval() const            { return m_interval; }
+    inline uint64_t report() const              { return m_report; }
+
+    rapidjson::Value toJSON(rapidjson::Document &doc) const;
+    void load(const rapidjson::Value &value);
+
+private:
+    Algorithm m_algorithm   = Algorithm::RX_0;
+    bool m_enabled          = false;
+    String m_host;
+    String m_jobs;
+    String m_seed;
+    uint16_t m_port         = 3333;
+    uint64_t m_diff         = 1000;
+    uint64_t m_interval     = 2000;
+    uint64_t m_report       = 60;
+};
+
+
+} // namespace xmrig
+
+
+#endif // XMRIG_EMULATORCONFIG_H
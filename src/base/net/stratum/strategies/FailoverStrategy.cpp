@@ -22,6 +22,23 @@
 #include "base/kernel/interfaces/IClient.h"
 #include "base/kernel/interfaces/IStrategyListener.h"
 #include "base/kernel/Platform.h"
+#include "base/io/log/Log.h"
+#include "base/net/stratum/Job.h"
+#include "base/tools/Chrono.h"
+
+
+namespace xmrig {
+
+
+// A pool left because of a threshold is not picked again for this long, so two similar pools do not flap.
+static constexpr uint64_t kSwitchHold   = 5 * 60 * 1000;
+
+// Reject rate is only judged after this many results and is averaged over roughly the last kRejectWindow.
+static constexpr uint32_t kRejectMin    = 10;
+static constexpr uint32_t kRejectWindow = 64;
+
+
+} // namespace xmrig
 
 
 xmrig::FailoverStrategy::FailoverStrategy(const std::vector<Pool> &pools, int retryPause, int retries, IStrategyListener *listener, bool quiet) :
@@ -55,13 +72,35 @@ xmrig::FailoverStrategy::~FailoverStrategy()
 
 void xmrig::FailoverStrategy::add(const Pool &pool)
 {
-    IClient *client = pool.createClient(static_cast<int>(m_pools.size()), this);
+    IClient *client = nullptr;
+
+    // Standby connections must be pinged even if the pool does not ask for it, it keeps NAT and the pool
+    // from dropping an idle socket and gives a latency sample.
+    if (m_hotStandby && pool.keepAlive() == 0) {
+        Pool copy(pool);
+        copy.setKeepAlive(true);
+
+        client = copy.createClient(static_cast<int>(m_pools.size()), this);
+    }
+    else {
+        client = pool.createClient(static_cast<int>(m_pools.size()), this);
+    }
 
     client->setRetries(m_retries);
     client->setRetryPause(m_retryPause * 1000);
     client->setQuiet(m_quiet);
 
     m_pools.push_back(client);
+    m_standby.emplace_back();
+}
+
+
+void xmrig::FailoverStrategy::setHotStandby(uint32_t switchLatency, uint32_t switchRejectRate, uint32_t switchJobTimeout)
+{
+    m_hotStandby        = true;
+    m_switchLatency     = switchLatency;
+    m_switchRejectRate  = switchRejectRate;
+    m_switchJobTimeout  = switchJobTimeout * 1000ULL;
 }
 
 
@@ -77,7 +116,13 @@ int64_t xmrig::FailoverStrategy::submit(const JobResult &result)
 
 void xmrig::FailoverStrategy::connect()
 {
-    m_pools[m_index]->connect();
+    if (!m_hotStandby) {
+        return m_pools[m_index]->connect();
+    }
+
+    for (IClient *client : m_pools) {
+        client->connect();
+    }
 }
 
 
@@ -116,6 +161,10 @@ void xmrig::FailoverStrategy::stop()
     m_index  = 0;
     m_active = -1;
 
+    for (auto &standby : m_standby) {
+        standby = Standby();
+    }
+
     m_listener->onPause(this);
 }
 
@@ -125,6 +174,37 @@ void xmrig::FailoverStrategy::tick(uint64_t now)
     for (IClient *client : m_pools) {
         client->tick(now);
     }
+
+    if (!m_hotStandby) {
+        return;
+    }
+
+    const int index = best(now, false);
+    if (index < 0 || index == m_active) {
+        return;
+    }
+
+    if (isActive()) {
+        const char *reason = unhealthy(static_cast<size_t>(m_active), now);
+
+        // A healthy active pool is only replaced by a pool with higher priority.
+        if (!reason && index > m_active) {
+            return;
+        }
+
+        if (reason) {
+            if (!m_quiet) {
+                LOG_WARN("%s " YELLOW("%s, switching to ") CYAN_BOLD("%s"), active()->tag(), reason, m_pools[static_cast<size_t>(index)]->pool().url().data());
+            }
+
+            auto &standby    = m_standby[static_cast<size_t>(m_active)];
+            standby.hold     = now + kSwitchHold;
+            standby.accepted = 0;
+            standby.rejected = 0;
+        }
+    }
+
+    activate(index, true);
 }
 
 
@@ -134,6 +214,23 @@ void xmrig::FailoverStrategy::onClose(IClient *client, int failures)
         return;
     }
 
+    if (m_hotStandby) {
+        m_standby[static_cast<size_t>(client->id())].ready = false;
+
+        if (m_active == client->id()) {
+            m_active = -1;
+
+            const int index = best(Chrono::steadyMSecs(), true);
+            if (index >= 0) {
+                return activate(index, true);
+            }
+
+            m_listener->onPause(this);
+        }
+
+        return;
+    }
+
     if (m_active == client->id()) {
         m_active = -1;
         m_listener->onPause(this);
@@ -157,6 +254,8 @@ void xmrig::FailoverStrategy::onLogin(IClient *client, rapidjson::Document &doc,
 
 void xmrig::FailoverStrategy::onJobReceived(IClient *client, const Job &job, const rapidjson::Value &params)
 {
+    m_standby[static_cast<size_t>(client->id())].jobTs = Chrono::steadyMSecs();
+
     if (m_active == client->id()) {
         m_listener->onJob(this, client, job, params);
     }
@@ -165,6 +264,22 @@ void xmrig::FailoverStrategy::onJobReceived(IClient *client, const Job &job, con
 
 void xmrig::FailoverStrategy::onLoginSuccess(IClient *client)
 {
+    if (m_hotStandby) {
+        const auto index = static_cast<size_t>(client->id());
+        const uint64_t now = Chrono::steadyMSecs();
+
+        m_standby[index].ready    = true;
+        m_standby[index].accepted = 0;
+        m_standby[index].rejected = 0;
+        m_standby[index].jobTs    = now;
+
+        if (!isActive() || (client->id() < m_active && m_standby[index].hold <= now && !unhealthy(index, now))) {
+            activate(client->id(), false);
+        }
+
+        return;
+    }
+
     int active = m_active;
 
     if (client->id() == 0 || !isActive()) {
@@ -186,6 +301,21 @@ void xmrig::FailoverStrategy::onLoginSuccess(IClient *client)
 
 void xmrig::FailoverStrategy::onResultAccepted(IClient *client, const SubmitResult &result, const char *error)
 {
+    if (m_hotStandby) {
+        auto &standby = m_standby[static_cast<size_t>(client->id())];
+        if (error) {
+            ++standby.rejected;
+        }
+        else {
+            ++standby.accepted;
+        }
+
+        if (standby.accepted + standby.rejected > kRejectWindow) {
+            standby.accepted /= 2;
+            standby.rejected /= 2;
+        }
+    }
+
     m_listener->onResultAccepted(this, client, result, error);
 }
 
@@ -194,3 +324,64 @@ void xmrig::FailoverStrategy::onVerifyAlgorithm(const IClient *client, const Alg
 {
     m_listener->onVerifyAlgorithm(this, client, algorithm, ok);
 }
+
+
+const char *xmrig::FailoverStrategy::unhealthy(size_t index, uint64_t now) const
+{
+    const auto &standby = m_standby[index];
+    const IClient *client = m_pools[index];
+
+    if (!standby.ready || !client->job().isValid()) {
+        return "not ready";
+    }
+
+    if (m_switchLatency && client->latency() > m_switchLatency) {
+        return "latency above limit";
+    }
+
+    const uint32_t results = standby.accepted + standby.rejected;
+    if (m_switchRejectRate && results >= kRejectMin && standby.rejected * 100 > m_switchRejectRate * results) {
+        return "reject rate above limit";
+    }
+
+    if (m_switchJobTimeout && now > standby.jobTs + m_switchJobTimeout) {
+        return "no new job";
+    }
+
+    return nullptr;
+}
+
+
+int xmrig::FailoverStrategy::best(uint64_t now, bool fallback) const
+{
+    for (size_t i = 0; i < m_pools.size(); ++i) {
+        if (m_standby[i].hold <= now && !unhealthy(i, now)) {
+            return static_cast<int>(i);
+        }
+    }
+
+    if (!fallback) {
+        return -1;
+    }
+
+    for (size_t i = 0; i < m_pools.size(); ++i) {
+        if (m_standby[i].ready && m_pools[i]->job().isValid()) {
+            return static_cast<int>(i);
+        }
+    }
+
+    return -1;
+}
+
+
+void xmrig::FailoverStrategy::activate(int index, bool job)
+{
+    m_index = m_active = index;
+
+    IClient *client = active();
+    m_listener->onActive(this, client);
+
+    if (job) {
+        m_listener->onJob(this, client, client->job(), rapidjson::Value(rapidjson::kNullType));
+    }
+}
@@ -46,6 +46,7 @@ public:
     ~FailoverStrategy() override;
 
     void add(const Pool &pool);
+    void setHotStandby(uint32_t switchLatency, uint32_t switchRejectRate, uint32_t switchJobTimeout);
 
 protected:
     inline bool isActive() const override           { return m_active >= 0; }
@@ -67,8 +68,22 @@ protected:
     void onVerifyAlgorithm(const IClient *client, const Algorithm &algorithm, bool *ok) override;
 
 private:
+    struct Standby
+    {
+        bool ready          = false;
+        uint32_t accepted   = 0;
+        uint32_t rejected   = 0;
+        uint64_t hold       = 0;
+        uint64_t jobTs      = 0;
+    };
+
     inline IClient *active() const { return m_pools[static_cast<size_t>(m_active)]; }
 
+    const char *unhealthy(size_t index, uint64_t now) const;
+    int best(uint64_t now, bool fallback) const;
+    void activate(int index, bool job);
+
+    bool m_hotStandby       = false;
     const bool m_quiet;
     const int m_retries;
     const int m_retryPause;
@@ -76,6 +91,10 @@ private:
     IStrategyListener *m_listener;
     size_t m_index          = 0;
     std::vector<IClient*> m_pools;
+    std::vector<Standby> m_standby;
+    uint32_t m_switchLatency        = 0;
+    uint32_t m_switchRejectRate     = 0;
+    uint64_t m_switchJobTimeout     = 0;
 };
 
 
@@ -23,55 +23,97 @@
 #include "base/kernel/interfaces/ILineListener.h"
 #include "base/net/tools/NetBuffer.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 
 
+namespace xmrig {
+
+
+static size_t maxLineSize   = XMRIG_NET_MAX_LINE_SIZE;
+static uint64_t bytesCopied = 0;
+static uint64_t bytesParsed = 0;
+
+
+} // namespace xmrig
+
+
 xmrig::LineReader::~LineReader()
 {
-    NetBuffer::release(m_buf);
+    release();
+}
+
+
+size_t xmrig::LineReader::maxSize()
+{
+    return maxLineSize;
+}
+
+
+void xmrig::LineReader::setMaxSize(size_t size)
+{
+    maxLineSize = std::max(size, XMRIG_NET_BUFFER_CHUNK_SIZE);
 }
 
 
-void xmrig::LineReader::parse(char *data, size_t size)
+uint64_t xmrig::LineReader::totalCopied()
+{
+    return bytesCopied;
+}
+
+
+uint64_t xmrig::LineReader::totalParsed()
+{
+    return bytesParsed;
+}
+
+
+bool xmrig::LineReader::parse(char *data, size_t size)
 {
     assert(m_listener != nullptr && size > 0);
     if (!m_listener || size == 0) {
-        return;
+        return true;
     }
 
-    getline(data, size);
+    if (getline(data, size)) {
+        return true;
+    }
+
+    reset();
+
+    return false;
 }
 
 
 void xmrig::LineReader::reset()
 {
-    if (m_buf) {
-        NetBuffer::release(m_buf);
-        m_buf = nullptr;
-        m_pos = 0;
-    }
+    release();
+
+    m_pos = 0;
 }
 
 
-void xmrig::LineReader::add(const char *data, size_t size)
+bool xmrig::LineReader::add(const char *data, size_t size)
 {
-    if (size + m_pos > XMRIG_NET_BUFFER_CHUNK_SIZE) {
-        // it breaks correctness silently for long lines
-        return;
+    // +1 for the line terminator, it is stored together with the line
+    if (size + m_pos > maxLineSize + 1) {
+        return false;
     }
 
-    if (!m_buf) {
-        m_buf = NetBuffer::allocate();
-        m_pos = 0;
+    if (size + m_pos > m_capacity) {
+        grow(size + m_pos);
     }
 
     memcpy(m_buf + m_pos, data, size);
-    m_pos += size;
+    m_pos       += size;
+    bytesCopied += size;
+
+    return true;
 }
 
 
-void xmrig::LineReader::getline(char *data, size_t size)
+bool xmrig::LineReader::getline(char *data, size_t size)
 {
     char *end        = nullptr;
     char *start      = data;
@@ -84,11 +126,19 @@ void xmrig::LineReader::getline(char *data, size_t size)
 
         const auto len = static_cast<size_t>(end - start);
         if (m_pos) {
-            add(start, len);
+            if (!add(start, len)) {
+                return false;
+            }
+
             m_listener->onLine(m_buf, m_pos - 1);
             m_pos = 0;
         }
+        else if (len > maxLineSize + 1) {
+            return false;
+        }
         else if (len > 1) {
+            // Complete line inside the network buffer, no copy required
+            bytesParsed += len;
             m_listener->onLine(start, len - 1);
         }
 
@@ -97,8 +147,60 @@ void xmrig::LineReader::getline(char *data, size_t size)
     }
 
     if (remaining == 0) {
-        return reset();
+        reset();
+
+        return true;
+    }
+
+    return add(start, remaining);
+}
+
+
+void xmrig::LineReader::grow(size_t size)
+{
+    // Most partial lines fit into a pooled network chunk, only long lines spill to the heap
+    if (!m_buf && size <= XMRIG_NET_BUFFER_CHUNK_SIZE) {
+        m_buf      = NetBuffer::allocate();
+        m_capacity = XMRIG_NET_BUFFER_CHUNK_SIZE;
+        m_pooled   = true;
+
+        return;
+    }
+
+    size_t capacity = std::max(m_capacity, XMRIG_NET_BUFFER_CHUNK_SIZE);
+    while (capacity < size) {
+        capacity *= 2;
+    }
+
+    capacity = std::min(capacity, maxLineSize + 1);
+
+    auto buf = new char[capacity];
+    if (m_pos) {
+        memcpy(buf, m_buf, m_pos);
+    }
+
+    release();
+
+    m_buf      = buf;
+    m_capacity = capacity;
+    m_pooled   = false;
+}
+
+
+void xmrig::LineReader::release()
+{
+    if (!m_buf) {
+        return;
+    }
+
+    if (m_pooled) {
+        NetBuffer::release(m_buf);
+    }
+    else {
+        delete [] m_buf;
     }
 
-    add(start, remaining);
+    m_buf      = nullptr;
+    m_capacity = 0;
+    m_pooled   = false;
 }
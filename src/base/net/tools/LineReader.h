@@ -25,6 +25,7 @@
 
 
 #include <cstddef>
+#include <cstdint>
 
 
 namespace xmrig {
@@ -42,17 +43,28 @@ public:
     LineReader(ILineListener *listener) : m_listener(listener) {}
     ~LineReader();
 
+    static size_t maxSize();
+    static void setMaxSize(size_t size);
+
+    // Process-wide totals of all readers, bytes handed to listeners in place and bytes copied to join split lines.
+    static uint64_t totalCopied();
+    static uint64_t totalParsed();
+
     inline void setListener(ILineListener *listener) { m_listener = listener; }
 
-    void parse(char *data, size_t size);
+    bool parse(char *data, size_t size);
     void reset();
 
 private:
-    void add(const char *data, size_t size);
-    void getline(char *data, size_t size);
+    bool add(const char *data, size_t size);
+    bool getline(char *data, size_t size);
+    void grow(size_t size);
+    void release();
 
     char *m_buf                 = nullptr;
+    bool m_pooled               = false;
     ILineListener *m_listener   = nullptr;
+    size_t m_capacity           = 0;
     size_t m_pos                = 0;
 };
 
@@ -0,0 +1,140 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "base/tools/cryptonote/MinerSignature.h"
+#include "base/crypto/keccak.h"
+#include "base/tools/Cvt.h"
+
+extern "C" {
+
+#include "base/tools/cryptonote/crypto-ops.h"
+
+}
+
+#include <cstring>
+
+#ifdef XMRIG_PROXY_PROJECT
+#define PROFILE_SCOPE(x)
+#else
+#include "crypto/rx/Profiler.h"
+#endif
+
+
+namespace xmrig {
+
+
+static inline void keccak256(const uint8_t *blocks, size_t count, uint8_t *md)
+{
+    uint64_t st[25] = {};
+
+    for (size_t i = 0; i < count; ++i, blocks += MinerSignature::kRate) {
+        for (size_t j = 0; j < MinerSignature::kRate / 8; ++j) {
+            st[j] ^= reinterpret_cast<const uint64_t *>(blocks)[j];
+        }
+
+        keccakf(st, 24);
+    }
+
+    memcpy(md, st, 32);
+}
+
+
+static inline void pad(uint8_t *block, size_t size, size_t total)
+{
+    memset(block + size, 0, total - size);
+    block[size]       = 0x01;
+    block[total - 1] |= 0x80;
+}
+
+
+} /* namespace xmrig */
+
+
+bool xmrig::MinerSignature::reset(const uint8_t *blob, size_t size, size_t offset, const uint8_t *pub, const uint8_t *sec)
+{
+    m_blocks = 0;
+
+    if (offset + kSize > size || size >= sizeof(m_msg)) {
+        return false;
+    }
+
+    m_offset = offset;
+    m_blocks = size / kRate + 1;
+
+    memcpy(m_msg, blob, size);
+    memset(m_msg + offset, 0, kSize);
+    pad(m_msg, size, m_blocks * kRate);
+
+    memcpy(m_comm + 32, pub, 32);
+    pad(m_comm, 96, kRate);
+
+    memcpy(m_sec, sec, sizeof(m_sec));
+
+    return true;
+}
+
+
+void xmrig::MinerSignature::sign(const uint8_t *blob, uint8_t *out)
+{
+    PROFILE_SCOPE(GenerateSignature);
+
+    // Only the bytes before the signature change between hashes of the same job (nonce and benchmark salt),
+    // everything after it is already in place and padded.
+    memcpy(m_msg, blob, m_offset);
+    keccak256(m_msg, m_blocks, m_comm);
+
+    uint8_t *c = out;
+    uint8_t *r = out + 32;
+
+    do {
+        if (m_pos == kBatch) {
+            refill();
+        }
+
+        const size_t i = m_pos++;
+
+        memcpy(m_comm + 64, m_R[i], 32);
+        keccak256(m_comm, 1, c);
+        sc_reduce32(c);
+
+        if (!sc_isnonzero(c)) {
+            continue;
+        }
+
+        sc_mulsub(r, c, m_sec, m_k[i]);
+    } while (!sc_isnonzero(c) || !sc_isnonzero(r));
+}
+
+
+void xmrig::MinerSignature::refill()
+{
+    // Every k is independent and used once, reusing or relating them would leak the secret key.
+    ge_p3 R[kBatch];
+
+    Cvt::randomBytes(m_k, sizeof(m_k));
+
+    for (size_t i = 0; i < kBatch; ++i) {
+        sc_reduce32(m_k[i]);
+        ge_scalarmult_base(&R[i], m_k[i]);
+    }
+
+    ge_p3_tobytes_batch(m_R[0], R, kBatch);
+
+    m_pos = 0;
+}
@@ -0,0 +1,65 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef XMRIG_MINERSIGNATURE_H
+#define XMRIG_MINERSIGNATURE_H
+
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace xmrig {
+
+
+// Per-thread signer for RandomX jobs with a miner signature: the Keccak input is kept pre-padded with the signature zeroed,
+// and nonces k with their commitments k*G are generated in batches that share a single field inversion.
+class MinerSignature
+{
+public:
+    static constexpr size_t kBatch      = 16;
+    static constexpr size_t kRate       = 136;
+    static constexpr size_t kMaxBlocks  = 4;
+    static constexpr size_t kSize       = 64;
+
+    MinerSignature() = default;
+
+    bool reset(const uint8_t *blob, size_t size, size_t offset, const uint8_t *pub, const uint8_t *sec);
+    void sign(const uint8_t *blob, uint8_t *out);
+
+    inline bool isValid() const { return m_blocks > 0; }
+
+private:
+    void refill();
+
+    alignas(8) uint8_t m_comm[kRate]{};
+    alignas(8) uint8_t m_msg[kRate * kMaxBlocks]{};
+    size_t m_blocks     = 0;
+    size_t m_offset     = 0;
+    size_t m_pos        = kBatch;
+    uint8_t m_k[kBatch][32]{};
+    uint8_t m_R[kBatch][32]{};
+    uint8_t m_sec[32]{};
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_MINERSIGNATURE_H */
@@ -30,6 +30,8 @@
 
 #pragma once
 
+#include <stddef.h>
+
 /* From fe.h */
 
 typedef int32_t fe[10];
@@ -112,6 +114,7 @@ void ge_p3_to_p2(ge_p2 *, const ge_p3 *);
 /* From ge_p3_tobytes.c */
 
 void ge_p3_tobytes(unsigned char *, const ge_p3 *);
+void ge_p3_tobytes_batch(unsigned char *, const ge_p3 *, size_t);
 
 /* From ge_scalarmult_base.c */
 
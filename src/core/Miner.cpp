@@ -17,6 +17,7 @@
  */
 
 #include <algorithm>
+#include <memory>
 #include <mutex>
 #include <thread>
 
@@ -25,6 +26,7 @@
 #include "core/Taskbar.h"
 #include "3rdparty/rapidjson/document.h"
 #include "backend/common/Hashrate.h"
+#include "backend/common/Profile.h"
 #include "backend/cpu/Cpu.h"
 #include "backend/cpu/CpuBackend.h"
 #include "base/io/log/Log.h"
@@ -41,6 +43,7 @@
 
 #ifdef XMRIG_FEATURE_API
 #   include "base/api/Api.h"
+#   include "base/api/Metrics.h"
 #   include "base/api/interfaces/IApiRequest.h"
 #endif
 
@@ -225,6 +228,56 @@ public:
             reply.PushBack(backend->toJSON(doc), allocator);
         }
     }
+
+
+    void getMetrics(Metrics &metrics) const
+    {
+        static const std::pair<const char *, size_t> windows[] = {
+            { "10s", Hashrate::ShortInterval },
+            { "60s", Hashrate::MediumInterval },
+            { "15m", Hashrate::LargeInterval }
+        };
+
+        metrics.family("xmrig_miner_enabled", Metrics::kGauge, "Mining is enabled (not paused).");
+        metrics.add("xmrig_miner_enabled", static_cast<uint64_t>(enabled));
+
+        metrics.family("xmrig_hashrate", Metrics::kGauge, "Hashrate per backend in H/s.");
+
+        for (IBackend *backend : backends) {
+            const Hashrate *hr = backend->hashrate();
+            if (!hr) {
+                continue;
+            }
+
+            for (const auto &window : windows) {
+                metrics.add("xmrig_hashrate", hr->calc(window.second), { { "backend", backend->type().data() }, { "window", window.first } });
+            }
+        }
+
+        metrics.family("xmrig_hashrate_highest", Metrics::kGauge, "Highest 10s hashrate for the current algorithm in H/s.");
+        metrics.add("xmrig_hashrate_highest", maxHashrate.count(algorithm) ? maxHashrate.at(algorithm) : 0.0, { { "algo", algorithm.name() } });
+
+        metrics.family("xmrig_thread_hashrate", Metrics::kGauge, "10s hashrate per worker thread in H/s.");
+
+        char id[24];
+
+        for (IBackend *backend : backends) {
+            const Hashrate *hr = backend->hashrate();
+            if (!hr) {
+                continue;
+            }
+
+            for (size_t i = 0; i < hr->threads(); i++) {
+                snprintf(id, sizeof(id), "%zu", i);
+                metrics.add("xmrig_thread_hashrate", hr->calc(i, Hashrate::ShortInterval), { { "backend", backend->type().data() }, { "thread", id } });
+            }
+        }
+
+        metrics.family("xmrig_nonces_reserved", Metrics::kCounter, "Nonces handed out to workers.");
+        metrics.add("xmrig_nonces_reserved_total", Nonce::reserved());
+
+        Profile::toMetrics(metrics);
+    }
 #   endif
 
 
@@ -344,7 +397,13 @@ public:
 
 
 #   ifdef XMRIG_ALGO_RANDOMX
-    inline bool initRX() const { return Rx::init(job, controller->config()->rx(), controller->config()->cpu()); }
+    inline bool initRX() const
+    {
+        const bool ready = Rx::init(job, controller->config()->rx(), controller->config()->cpu());
+        Rx::precompute(job, controller->config()->rx(), controller->config()->cpu());
+
+        return ready;
+    }
 #   endif
 
 
@@ -363,6 +422,7 @@ public:
     bool reset          = true;
     Controller *controller;
     Job job;
+    std::shared_ptr<const Job> shared[Nonce::MAX];
     mutable std::map<Algorithm::Id, double> maxHashrate;
     std::vector<IBackend *> backends;
     String userJobId;
@@ -390,6 +450,8 @@ xmrig::Miner::Miner(Controller *controller)
     ProfileScopeData::Init();
 #   endif
 
+    Profile::setEnabled(controller->config()->isProfile());
+
 #   ifdef XMRIG_ALGO_RANDOMX
     Rx::init(this);
 #   endif
@@ -455,6 +517,16 @@ xmrig::Job xmrig::Miner::job() const
 }
 
 
+std::shared_ptr<const xmrig::Job> xmrig::Miner::job(uint32_t backend) const
+{
+    static const std::shared_ptr<const Job> empty = std::make_shared<Job>();
+
+    auto job = backend < Nonce::MAX ? std::atomic_load(&d_ptr->shared[backend]) : nullptr;
+
+    return job ? job : empty;
+}
+
+
 void xmrig::Miner::execCommand(char command)
 {
     switch (command) {
@@ -480,6 +552,15 @@ void xmrig::Miner::execCommand(char command)
         }
         break;
 
+    case 'f':
+    case 'F':
+        if (Profile::isEnabled()) {
+            Profile::print();
+        }
+
+        Profile::setEnabled(!Profile::isEnabled());
+        break;
+
     default:
         break;
     }
@@ -544,7 +625,18 @@ void xmrig::Miner::setJob(const Job &job, bool donate)
 
 #   ifdef XMRIG_ALGO_RANDOMX
     if (job.algorithm().family() == Algorithm::RANDOM_X && !Rx::isReady(job)) {
-        if (d_ptr->algorithm != job.algorithm()) {
+        if (d_ptr->algorithm != job.algorithm() && d_ptr->controller->config()->cpu().isPersistentThreads()) {
+            // CPU threads only pause until the dataset is ready, CpuBackend::setJob() then parks them and creates new workers
+            Nonce::pause(true);
+            Nonce::touch();
+
+            for (IBackend *backend : d_ptr->backends) {
+                if (backend->type() != "cpu") {
+                    backend->stop();
+                }
+            }
+        }
+        else if (d_ptr->algorithm != job.algorithm()) {
             stop();
         }
         else {
@@ -574,6 +666,14 @@ void xmrig::Miner::setJob(const Job &job, bool donate)
         d_ptr->userJobId = job.id();
     }
 
+    // Decode once per backend, workers only swap the pointer and copy the blob into their nonce lanes.
+    for (uint32_t backend = 0; backend < Nonce::MAX; ++backend) {
+        auto shared = std::make_shared<Job>(d_ptr->job);
+        shared->setBackend(backend);
+
+        std::atomic_store(&d_ptr->shared[backend], std::shared_ptr<const Job>(std::move(shared)));
+    }
+
 #   ifdef XMRIG_ALGO_RANDOMX
     const bool ready = d_ptr->initRX();
 #   else
@@ -611,6 +711,10 @@ void xmrig::Miner::onConfigChanged(Config *config, Config *previousConfig)
 {
     d_ptr->rebuild();
 
+    if (config->isProfile() != previousConfig->isProfile()) {
+        Profile::setEnabled(config->isProfile());
+    }
+
     if (config->pools() != previousConfig->pools() && config->pools().active() > 0) {
         return;
     }
@@ -694,6 +798,16 @@ void xmrig::Miner::onRequest(IApiRequest &request)
 
             d_ptr->getBackends(request.reply(), request.doc());
         }
+        else if (request.type() == IApiRequest::REQ_METRICS) {
+            request.accept();
+
+            d_ptr->getMetrics(request.metrics());
+        }
+        else if (request.url() == "/2/profile") {
+            request.accept();
+
+            request.reply() = Profile::toJSON(request.doc());
+        }
     }
     else if (request.type() == IApiRequest::REQ_JSON_RPC) {
         if (request.rpcMethod() == "pause") {
@@ -711,6 +825,21 @@ void xmrig::Miner::onRequest(IApiRequest &request)
 
             stop();
         }
+        else if (request.rpcMethod() == "profile_start") {
+            request.accept();
+
+            Profile::setEnabled(true);
+        }
+        else if (request.rpcMethod() == "profile_stop") {
+            request.accept();
+
+            Profile::setEnabled(false);
+        }
+        else if (request.rpcMethod() == "profile_reset") {
+            request.accept();
+
+            Profile::reset();
+        }
     }
 
     for (IBackend *backend : d_ptr->backends) {
@@ -20,6 +20,7 @@
 #define XMRIG_MINER_H
 
 
+#include <memory>
 #include <vector>
 
 
@@ -53,6 +54,7 @@ public:
     const Algorithms &algorithms() const;
     const std::vector<IBackend *> &backends() const;
     Job job() const;
+    std::shared_ptr<const Job> job(uint32_t backend) const;
     void execCommand(char command);
     void pause();
     void setEnabled(bool enabled);
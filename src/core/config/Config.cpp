@@ -54,6 +54,7 @@ constexpr static uint32_t kIdleTime     = 60U;
 
 const char *Config::kPauseOnBattery     = "pause-on-battery";
 const char *Config::kPauseOnActive      = "pause-on-active";
+const char *Config::kProfile            = "profile";
 
 
 #ifdef XMRIG_FEATURE_OPENCL
@@ -77,6 +78,7 @@ class ConfigPrivate
 {
 public:
     bool pauseOnBattery = false;
+    bool profile        = false;
     CpuConfig cpu;
     uint32_t idleTime   = 0;
 
@@ -132,6 +134,12 @@ bool xmrig::Config::isPauseOnBattery() const
 }
 
 
+bool xmrig::Config::isProfile() const
+{
+    return d_ptr->profile;
+}
+
+
 const xmrig::CpuConfig &xmrig::Config::cpu() const
 {
     return d_ptr->cpu;
@@ -214,6 +222,7 @@ bool xmrig::Config::read(const IJsonReader &reader, const char *fileName)
 
     d_ptr->pauseOnBattery = reader.getBool(kPauseOnBattery, d_ptr->pauseOnBattery);
     d_ptr->setIdleTime(reader.getValue(kPauseOnActive));
+    d_ptr->profile        = reader.getBool(kProfile, d_ptr->profile);
 
     d_ptr->cpu.read(reader.getValue(CpuConfig::kField));
 
@@ -261,6 +270,11 @@ void xmrig::Config::getJSON(rapidjson::Document &doc) const
 
     doc.AddMember(StringRef(kApi),                      api, allocator);
     doc.AddMember(StringRef(kHttp),                     m_http.toJSON(doc), allocator);
+
+#   ifdef XMRIG_FEATURE_EMULATOR
+    doc.AddMember(StringRef(EmulatorConfig::kField),    m_emulator.toJSON(doc), allocator);
+#   endif
+
     doc.AddMember(StringRef(kAutosave),                 isAutoSave(), allocator);
     doc.AddMember(StringRef(kBackground),               isBackground(), allocator);
     doc.AddMember(StringRef(kColors),                   Log::isColors(), allocator);
@@ -281,6 +295,7 @@ void xmrig::Config::getJSON(rapidjson::Document &doc) const
 #   endif
 
     doc.AddMember(StringRef(kLogFile),                  m_logFile.toJSON(), allocator);
+    doc.AddMember(StringRef(kLogFileSize),              m_logFileSize, allocator);
 
     m_pools.toJSON(doc, doc);
 
@@ -305,4 +320,5 @@ void xmrig::Config::getJSON(rapidjson::Document &doc) const
     doc.AddMember(StringRef(kWatch),                    m_watch, allocator);
     doc.AddMember(StringRef(kPauseOnBattery),           isPauseOnBattery(), allocator);
     doc.AddMember(StringRef(kPauseOnActive),            (d_ptr->idleTime == 0U || d_ptr->idleTime == kIdleTime) ? Value(isPauseOnActive()) : Value(d_ptr->idleTime), allocator);
+    doc.AddMember(StringRef(kProfile),                  isProfile(), allocator);
 }
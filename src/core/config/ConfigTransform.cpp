@@ -260,6 +260,7 @@ void xmrig::ConfigTransform::transform(rapidjson::Document &doc, int key, const
     case IConfig::BenchTokenKey:    /* --token */
     case IConfig::BenchSeedKey:     /* --seed */
     case IConfig::BenchHashKey:     /* --hash */
+    case IConfig::BenchSignatureKey: /* --bench-signature */
     case IConfig::UserKey:          /* --user */
     case IConfig::RotationKey:      /* --rotation */
         return transformBenchmark(doc, key, arg);
@@ -350,6 +351,9 @@ void xmrig::ConfigTransform::transformBenchmark(rapidjson::Document &doc, int ke
     case IConfig::BenchHashKey: /* --hash */
         return set(doc, BenchConfig::kBenchmark, BenchConfig::kHash, arg);
 
+    case IConfig::BenchSignatureKey: /* --bench-signature */
+        return set(doc, BenchConfig::kBenchmark, BenchConfig::kSignature, true);
+
     case IConfig::UserKey: /* --user */
         return set(doc, BenchConfig::kBenchmark, BenchConfig::kUser, arg);
 
@@ -53,7 +53,11 @@ R"===(
         "wrmsr": true,
         "cache_qos": false,
         "numa": true,
-        "scratchpad_prefetch_mode": 1
+        "scratchpad_prefetch_mode": 1,
+        "dataset-cache": null,
+        "dataset-cache-max": 2,
+        "precompute": false,
+        "precompute-threads": 1
     },
     "cpu": {
         "enabled": true,
@@ -63,6 +67,7 @@ R"===(
         "priority": null,
         "memory-pool": false,
         "yield": true,
+        "persistent-threads": true,
         "max-threads-hint": 100,
         "asm": true,
         "argon2-impl": null,
@@ -88,6 +93,7 @@ R"===(
     "donate-level": 1,
     "donate-over-proxy": 1,
     "log-file": null,
+    "log-file-size": 0,
     "pools": [
         {
             "algo": null,
@@ -112,6 +118,13 @@ R"===(
     "dmi": true,
     "retries": 5,
     "retry-pause": 5,
+    "max-line-size": 1048576,
+    "submit-window": 0,
+    "submit-inflight": 0,
+    "hot-standby": false,
+    "switch-latency": 0,
+    "switch-reject-rate": 0,
+    "switch-job-timeout": 600,
     "syslog": false,
     "tls": {
         "enabled": false,
@@ -126,7 +139,8 @@ R"===(
     "verbose": 0,
     "watch": true,
     "pause-on-battery": false,
-    "pause-on-active": false
+    "pause-on-active": false,
+    "profile": false
 }
 )===";
 #endif
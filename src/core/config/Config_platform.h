@@ -65,6 +65,7 @@ static const option options[] = {
     { "dry-run",               0, nullptr, IConfig::DryRunKey             },
     { "keepalive",             0, nullptr, IConfig::KeepAliveKey          },
     { "log-file",              1, nullptr, IConfig::LogFileKey            },
+    { "log-file-size",         1, nullptr, IConfig::LogFileSizeKey        },
     { "nicehash",              0, nullptr, IConfig::NicehashKey           },
     { "no-color",              0, nullptr, IConfig::ColorKey              },
     { "no-huge-pages",         0, nullptr, IConfig::HugePagesKey          },
@@ -77,6 +78,13 @@ static const option options[] = {
     { "print-time",            1, nullptr, IConfig::PrintTimeKey          },
     { "retries",               1, nullptr, IConfig::RetriesKey            },
     { "retry-pause",           1, nullptr, IConfig::RetryPauseKey         },
+    { "max-line-size",         1, nullptr, IConfig::MaxLineSizeKey        },
+    { "submit-window",         1, nullptr, IConfig::SubmitWindowKey       },
+    { "submit-inflight",       1, nullptr, IConfig::SubmitInflightKey     },
+    { "hot-standby",           0, nullptr, IConfig::HotStandbyKey         },
+    { "switch-latency",        1, nullptr, IConfig::SwitchLatencyKey      },
+    { "switch-reject-rate",    1, nullptr, IConfig::SwitchRejectRateKey   },
+    { "switch-job-timeout",    1, nullptr, IConfig::SwitchJobTimeoutKey   },
     { "syslog",                0, nullptr, IConfig::SyslogKey             },
     { "threads",               1, nullptr, IConfig::ThreadsKey            },
     { "url",                   1, nullptr, IConfig::UrlKey                },
@@ -113,6 +121,7 @@ static const option options[] = {
 #   endif
     { "seed",                  1, nullptr, IConfig::BenchSeedKey          },
     { "hash",                  1, nullptr, IConfig::BenchHashKey          },
+    { "bench-signature",       0, nullptr, IConfig::BenchSignatureKey     },
 #   endif
 #   ifdef XMRIG_FEATURE_TLS
     { "tls",                   0, nullptr, IConfig::TlsKey                },
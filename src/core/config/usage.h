@@ -73,6 +73,13 @@ static inline const std::string &usage()
 
     u += "  -r, --retries=N               number of times to retry before switch to backup server (default: 5)\n";
     u += "  -R, --retry-pause=N           time to pause between retries (default: 5)\n";
+    u += "      --max-line-size=N         maximum size of a stratum message in bytes (default: 1048576)\n";
+    u += "      --submit-window=N         coalesce shares found within N ms into one write (default: 0)\n";
+    u += "      --submit-inflight=N       maximum number of unanswered shares per pool, 0 means no limit\n";
+    u += "      --hot-standby             keep backup pools logged in and switch to them without reconnecting\n";
+    u += "      --switch-latency=N        with --hot-standby leave a pool slower than N ms, 0 means never\n";
+    u += "      --switch-reject-rate=N    with --hot-standby leave a pool rejecting more than N%% of shares, 0 means never\n";
+    u += "      --switch-job-timeout=N    with --hot-standby leave a pool that sent no new job for N seconds (default: 600), 0 means never\n";
     u += "      --user-agent              set custom user-agent string for pool\n";
     u += "      --donate-level=N          donate level, default 1%% (1 minute in 100 minutes)\n";
     u += "      --donate-over-proxy=N     control donate over xmrig-proxy feature\n";
@@ -160,6 +167,7 @@ static inline const std::string &usage()
 #   endif
 
     u += "  -l, --log-file=FILE           log all output to a file\n";
+    u += "      --log-file-size=N         rotate log file to FILE.1 after N MB, 0 means never\n";
     u += "      --print-time=N            print hashrate report every N seconds\n";
 #   if defined(XMRIG_FEATURE_NVML) || defined(XMRIG_FEATURE_ADL)
     u += "      --health-print-time=N     print health report every N seconds\n";
@@ -195,6 +203,7 @@ static inline const std::string &usage()
 #   endif
     u += "      --seed=SEED               custom RandomX seed for benchmark\n";
     u += "      --hash=HASH               compare benchmark result with specified hash\n";
+    u += "      --bench-signature         sign every hash with a miner signature (RandomX only)\n";
 #   endif
 
 #   ifdef XMRIG_FEATURE_DMI
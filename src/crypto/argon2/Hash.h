@@ -49,6 +49,26 @@ inline void single_hash(const uint8_t *__restrict__ input, size_t size, uint8_t
 }
 
 
+template<Algorithm::Id ALGO, size_t N>
+inline void multi_hash(const uint8_t *__restrict__ input, size_t size, uint8_t *__restrict__ output, cryptonight_ctx **__restrict__ ctx, uint64_t)
+{
+    void *memory[N];
+    for (size_t i = 0; i < N; ++i) {
+        memory[i] = ctx[i]->memory;
+    }
+
+    if (ALGO == Algorithm::AR2_CHUKWA) {
+        argon2id_hash_raw_ex_multi(3, 512, N, input, size, 16, output, 32, memory);
+    }
+    else if (ALGO == Algorithm::AR2_CHUKWA_V2) {
+        argon2id_hash_raw_ex_multi(4, 1024, N, input, size, 16, output, 32, memory);
+    }
+    else if (ALGO == Algorithm::AR2_WRKZ) {
+        argon2id_hash_raw_ex_multi(4, 256, N, input, size, 16, output, 32, memory);
+    }
+}
+
+
 }} // namespace xmrig::argon2
 
 
@@ -360,14 +360,32 @@ xmrig::CnHash::CnHash()
     m_map[Algorithm::AR2_CHUKWA] = new cn_hash_fun_array{};
     m_map[Algorithm::AR2_CHUKWA]->data[AV_SINGLE][Assembly::NONE]         = argon2::single_hash<Algorithm::AR2_CHUKWA>;
     m_map[Algorithm::AR2_CHUKWA]->data[AV_SINGLE_SOFT][Assembly::NONE]    = argon2::single_hash<Algorithm::AR2_CHUKWA>;
+    m_map[Algorithm::AR2_CHUKWA]->data[AV_DOUBLE][Assembly::NONE]         = argon2::multi_hash<Algorithm::AR2_CHUKWA, 2>;
+    m_map[Algorithm::AR2_CHUKWA]->data[AV_DOUBLE_SOFT][Assembly::NONE]    = argon2::multi_hash<Algorithm::AR2_CHUKWA, 2>;
+    m_map[Algorithm::AR2_CHUKWA]->data[AV_TRIPLE][Assembly::NONE]         = argon2::multi_hash<Algorithm::AR2_CHUKWA, 3>;
+    m_map[Algorithm::AR2_CHUKWA]->data[AV_TRIPLE_SOFT][Assembly::NONE]    = argon2::multi_hash<Algorithm::AR2_CHUKWA, 3>;
+    m_map[Algorithm::AR2_CHUKWA]->data[AV_QUAD][Assembly::NONE]           = argon2::multi_hash<Algorithm::AR2_CHUKWA, 4>;
+    m_map[Algorithm::AR2_CHUKWA]->data[AV_QUAD_SOFT][Assembly::NONE]      = argon2::multi_hash<Algorithm::AR2_CHUKWA, 4>;
 
     m_map[Algorithm::AR2_CHUKWA_V2] = new cn_hash_fun_array{};
     m_map[Algorithm::AR2_CHUKWA_V2]->data[AV_SINGLE][Assembly::NONE]      = argon2::single_hash<Algorithm::AR2_CHUKWA_V2>;
     m_map[Algorithm::AR2_CHUKWA_V2]->data[AV_SINGLE_SOFT][Assembly::NONE] = argon2::single_hash<Algorithm::AR2_CHUKWA_V2>;
+    m_map[Algorithm::AR2_CHUKWA_V2]->data[AV_DOUBLE][Assembly::NONE]      = argon2::multi_hash<Algorithm::AR2_CHUKWA_V2, 2>;
+    m_map[Algorithm::AR2_CHUKWA_V2]->data[AV_DOUBLE_SOFT][Assembly::NONE] = argon2::multi_hash<Algorithm::AR2_CHUKWA_V2, 2>;
+    m_map[Algorithm::AR2_CHUKWA_V2]->data[AV_TRIPLE][Assembly::NONE]      = argon2::multi_hash<Algorithm::AR2_CHUKWA_V2, 3>;
+    m_map[Algorithm::AR2_CHUKWA_V2]->data[AV_TRIPLE_SOFT][Assembly::NONE] = argon2::multi_hash<Algorithm::AR2_CHUKWA_V2, 3>;
+    m_map[Algorithm::AR2_CHUKWA_V2]->data[AV_QUAD][Assembly::NONE]        = argon2::multi_hash<Algorithm::AR2_CHUKWA_V2, 4>;
+    m_map[Algorithm::AR2_CHUKWA_V2]->data[AV_QUAD_SOFT][Assembly::NONE]   = argon2::multi_hash<Algorithm::AR2_CHUKWA_V2, 4>;
 
     m_map[Algorithm::AR2_WRKZ] = new cn_hash_fun_array{};
     m_map[Algorithm::AR2_WRKZ]->data[AV_SINGLE][Assembly::NONE]           = argon2::single_hash<Algorithm::AR2_WRKZ>;
     m_map[Algorithm::AR2_WRKZ]->data[AV_SINGLE_SOFT][Assembly::NONE]      = argon2::single_hash<Algorithm::AR2_WRKZ>;
+    m_map[Algorithm::AR2_WRKZ]->data[AV_DOUBLE][Assembly::NONE]           = argon2::multi_hash<Algorithm::AR2_WRKZ, 2>;
+    m_map[Algorithm::AR2_WRKZ]->data[AV_DOUBLE_SOFT][Assembly::NONE]      = argon2::multi_hash<Algorithm::AR2_WRKZ, 2>;
+    m_map[Algorithm::AR2_WRKZ]->data[AV_TRIPLE][Assembly::NONE]           = argon2::multi_hash<Algorithm::AR2_WRKZ, 3>;
+    m_map[Algorithm::AR2_WRKZ]->data[AV_TRIPLE_SOFT][Assembly::NONE]      = argon2::multi_hash<Algorithm::AR2_WRKZ, 3>;
+    m_map[Algorithm::AR2_WRKZ]->data[AV_QUAD][Assembly::NONE]             = argon2::multi_hash<Algorithm::AR2_WRKZ, 4>;
+    m_map[Algorithm::AR2_WRKZ]->data[AV_QUAD_SOFT][Assembly::NONE]        = argon2::multi_hash<Algorithm::AR2_WRKZ, 4>;
 #   endif
 
 #   ifdef XMRIG_ALGO_GHOSTRIDER
@@ -392,42 +392,42 @@ const static uint8_t test_output_femto_upx2[256] = {
 const static uint8_t argon2_chukwa_test_out[256] = {
     0xC1, 0x58, 0xA1, 0x05, 0xAE, 0x75, 0xC7, 0x56, 0x1C, 0xFD, 0x02, 0x90, 0x83, 0xA4, 0x7A, 0x87,
     0x65, 0x3D, 0x51, 0xF9, 0x14, 0x12, 0x8E, 0x21, 0xC1, 0x97, 0x1D, 0x8B, 0x10, 0xC4, 0x90, 0x34,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+    0xC0, 0xDA, 0xD0, 0xEE, 0xB9, 0xC5, 0x2E, 0x92, 0xA1, 0xC3, 0xAA, 0x5B, 0x76, 0xA3, 0xCB, 0x90,
+    0xBD, 0x73, 0x76, 0xC2, 0x8D, 0xCE, 0x19, 0x1C, 0xEE, 0xB1, 0x09, 0x6E, 0x3A, 0x39, 0x0D, 0x2E,
+    0x36, 0x38, 0xC9, 0x94, 0x51, 0x30, 0xFD, 0xA8, 0x40, 0x65, 0xF8, 0xE2, 0xED, 0xBE, 0xD9, 0x13,
+    0x24, 0xC0, 0xE7, 0x7E, 0x50, 0xC1, 0xE1, 0x01, 0x5A, 0xAA, 0xDE, 0x83, 0xD3, 0xBD, 0x11, 0x49,
+    0x4A, 0x0C, 0x8E, 0xE0, 0xC2, 0xA6, 0xD6, 0xE2, 0x06, 0x2F, 0x40, 0x2F, 0xF6, 0xDF, 0xA4, 0x08,
+    0xC4, 0x85, 0xAA, 0xBD, 0xA8, 0x4E, 0x33, 0xD8, 0x89, 0x4A, 0xCA, 0x27, 0x4A, 0x56, 0x77, 0x11,
+    0x70, 0x45, 0x26, 0x60, 0x3B, 0x96, 0xF3, 0x87, 0xD9, 0xB2, 0xD1, 0xDF, 0x50, 0x3C, 0x81, 0xCF,
+    0xF1, 0x4A, 0x34, 0xFF, 0xEE, 0x34, 0xA8, 0x15, 0x8E, 0xC6, 0xD9, 0x10, 0x5B, 0x80, 0x0E, 0xE6
 };
 
 // "argon2/chukwav2"
 const static uint8_t argon2_chukwa_v2_test_out[256] = {
     0x77, 0xCF, 0x69, 0x58, 0xB3, 0x53, 0x6E, 0x1F, 0x9F, 0x0D, 0x1E, 0xA1, 0x65, 0xF2, 0x28, 0x11,
     0xCA, 0x7B, 0xC4, 0x87, 0xEA, 0x9F, 0x52, 0x03, 0x0B, 0x50, 0x50, 0xC1, 0x7F, 0xCD, 0xD8, 0xF5,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+    0x35, 0x78, 0xC1, 0x35, 0x26, 0x13, 0x66, 0xA7, 0xBA, 0xC4, 0x07, 0xB8, 0xC0, 0xFF, 0x50, 0xF3,
+    0xAD, 0x96, 0xF0, 0x96, 0xEC, 0x28, 0x13, 0xE9, 0x64, 0x4E, 0x6E, 0x77, 0xA4, 0x3F, 0x80, 0x3D,
+    0x19, 0x09, 0x6B, 0xD7, 0x83, 0x9D, 0x24, 0xD0, 0xF4, 0x4E, 0x81, 0x99, 0x6F, 0x03, 0x1A, 0xEE,
+    0x9D, 0xBA, 0xCE, 0x5D, 0xF9, 0xE4, 0x6A, 0xE8, 0x29, 0x68, 0x2A, 0xC1, 0x02, 0xE5, 0x5B, 0x6E,
+    0xA9, 0xB3, 0x43, 0x81, 0x33, 0xE8, 0x4D, 0x14, 0x56, 0x14, 0x5B, 0xE4, 0xEC, 0x39, 0x18, 0x61,
+    0x7E, 0x3E, 0xF2, 0x36, 0x81, 0x2D, 0x94, 0x30, 0x54, 0x58, 0xE5, 0x01, 0x7F, 0xD3, 0x99, 0x85,
+    0xD1, 0xC7, 0x7A, 0xAC, 0x22, 0xFF, 0x89, 0x17, 0x40, 0x52, 0xB9, 0x98, 0xED, 0x4E, 0xA8, 0x41,
+    0xC2, 0xDC, 0x4B, 0x8F, 0x61, 0xD2, 0x6D, 0x8B, 0x9C, 0x85, 0x5C, 0x11, 0x37, 0x97, 0xD6, 0xE9
 };
 
 // "argon2/wrkz"
 const static uint8_t argon2_wrkz_test_out[256] = {
     0x35, 0xE0, 0x83, 0xD4, 0xB9, 0xC6, 0x4C, 0x2A, 0x68, 0x82, 0x0A, 0x43, 0x1F, 0x61, 0x31, 0x19,
     0x98, 0xA8, 0xCD, 0x18, 0x64, 0xDB, 0xA4, 0x07, 0x7E, 0x25, 0xB7, 0xF1, 0x21, 0xD5, 0x4B, 0xD1,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+    0xB2, 0xFB, 0x90, 0x2B, 0xF4, 0x95, 0x99, 0x83, 0x9A, 0x61, 0xCA, 0x28, 0xA4, 0xF9, 0x81, 0xD5,
+    0x49, 0x68, 0x8F, 0xCD, 0x87, 0x59, 0xC4, 0x05, 0xE6, 0x79, 0xED, 0x9E, 0xF1, 0x36, 0xD1, 0xB9,
+    0x01, 0x97, 0xEB, 0xDB, 0x1A, 0x53, 0x6E, 0x8F, 0x21, 0xF5, 0x42, 0x74, 0x6C, 0xA9, 0x04, 0x31,
+    0x41, 0xBE, 0x16, 0x49, 0x97, 0x5A, 0x3B, 0x22, 0xC2, 0xAD, 0xED, 0xF8, 0x11, 0xCF, 0x50, 0x82,
+    0xAE, 0xF5, 0x6A, 0x69, 0x1F, 0x58, 0x3E, 0x3E, 0xEA, 0xD9, 0x4F, 0x6B, 0x13, 0xB4, 0x2B, 0x3D,
+    0x64, 0xBE, 0x0A, 0x9D, 0x72, 0x75, 0x64, 0x37, 0x87, 0x9A, 0x19, 0xCB, 0x6B, 0x75, 0x63, 0x0D,
+    0x4E, 0xB1, 0x9C, 0xCD, 0xD8, 0x91, 0xF1, 0xFF, 0x63, 0xDA, 0xCA, 0x70, 0xD1, 0xAC, 0x64, 0x11,
+    0x4B, 0x8A, 0x6B, 0xB5, 0x47, 0x7B, 0xCF, 0x14, 0x4F, 0x6C, 0x5E, 0x0E, 0x30, 0xA7, 0x9C, 0x57
 };
 #endif
 
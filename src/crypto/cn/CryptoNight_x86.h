@@ -48,6 +48,11 @@
 #endif
 
 
+#ifdef XMRIG_FEATURE_ASM
+#   include "crypto/cn/r/CnRCache.h"
+#endif
+
+
 extern "C"
 {
 #include "crypto/cn/c_groestl.h"
@@ -588,9 +593,6 @@ static inline __m128i int_sqrt_v2(const uint64_t n0)
 }
 
 
-void v4_soft_aes_compile_code(const V4_Instruction *code, int code_size, void *machine_code, xmrig::Assembly ASM);
-
-
 alignas(64) static const uint32_t tweak1_table[256] = { 268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456 };
 
 
@@ -691,13 +693,7 @@ inline void cryptonight_single_hash(const uint8_t *__restrict__ input, size_t si
 #   ifdef XMRIG_FEATURE_ASM
     if (SOFT_AES && props.isR()) {
         if (!ctx[0]->generated_code_data.match(ALGO, height)) {
-            V4_Instruction code[256];
-            const int code_size = v4_random_math_init<ALGO>(code, height);
-
-            if (ALGO == Algorithm::CN_R) {
-                v4_soft_aes_compile_code(code, code_size, reinterpret_cast<void*>(ctx[0]->generated_code), Assembly::NONE);
-            }
-
+            CnRCache::copy(ALGO, height, CnRCache::SOFT_AES, Assembly::NONE, reinterpret_cast<void*>(ctx[0]->generated_code));
             ctx[0]->generated_code_data = { ALGO, height };
         }
 
@@ -919,24 +915,6 @@ extern cn_mainloop_fun cn_gr5_quad_mainloop_asm;
 } // namespace xmrig
 
 
-void v4_compile_code(const V4_Instruction* code, int code_size, void* machine_code, xmrig::Assembly ASM);
-void v4_compile_code_double(const V4_Instruction* code, int code_size, void* machine_code, xmrig::Assembly ASM);
-
-
-template<xmrig::Algorithm::Id ALGO>
-void cn_r_compile_code(const V4_Instruction* code, int code_size, void* machine_code, xmrig::Assembly ASM)
-{
-    v4_compile_code(code, code_size, machine_code, ASM);
-}
-
-
-template<xmrig::Algorithm::Id ALGO>
-void cn_r_compile_code_double(const V4_Instruction* code, int code_size, void* machine_code, xmrig::Assembly ASM)
-{
-    v4_compile_code_double(code, code_size, machine_code, ASM);
-}
-
-
 namespace xmrig {
 
 
@@ -946,10 +924,7 @@ inline void cryptonight_single_hash_asm(const uint8_t *__restrict__ input, size_
     constexpr CnAlgo<ALGO> props;
 
     if (props.isR() && !ctx[0]->generated_code_data.match(ALGO, height)) {
-        V4_Instruction code[256];
-        const int code_size = v4_random_math_init<ALGO>(code, height);
-        cn_r_compile_code<ALGO>(code, code_size, reinterpret_cast<void*>(ctx[0]->generated_code), ASM);
-
+        CnRCache::copy(ALGO, height, CnRCache::SINGLE, ASM, reinterpret_cast<void*>(ctx[0]->generated_code));
         ctx[0]->generated_code_data = { ALGO, height };
     }
 
@@ -1052,10 +1027,7 @@ inline void cryptonight_double_hash_asm(const uint8_t *__restrict__ input, size_
     constexpr CnAlgo<ALGO> props;
 
     if (props.isR() && !ctx[0]->generated_code_data.match(ALGO, height)) {
-        V4_Instruction code[256];
-        const int code_size = v4_random_math_init<ALGO>(code, height);
-        cn_r_compile_code_double<ALGO>(code, code_size, reinterpret_cast<void*>(ctx[0]->generated_code), ASM);
-
+        CnRCache::copy(ALGO, height, CnRCache::DOUBLE, ASM, reinterpret_cast<void*>(ctx[0]->generated_code));
         ctx[0]->generated_code_data = { ALGO, height };
     }
 
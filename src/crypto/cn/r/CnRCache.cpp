@@ -0,0 +1,158 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+
+
+#include "crypto/cn/r/CnRCache.h"
+#include "crypto/cn/CryptoNight_monero.h"
+#include "crypto/cn/r/variant4_random_math.h"
+#include "crypto/common/VirtualMemory.h"
+
+
+size_t v4_compile_code(const V4_Instruction *code, int code_size, void *machine_code, xmrig::Assembly ASM);
+size_t v4_compile_code_double(const V4_Instruction *code, int code_size, void *machine_code, xmrig::Assembly ASM);
+size_t v4_soft_aes_compile_code(const V4_Instruction *code, int code_size, void *machine_code, xmrig::Assembly ASM);
+
+
+namespace xmrig {
+
+
+static constexpr size_t kSlots      = 16;
+static constexpr size_t kMaxSize    = 0x4000;
+
+
+struct CnRProgram
+{
+    inline bool match(Algorithm::Id a, uint64_t h, CnRCache::Variant v, Assembly::Id asmId) const { return algo == a && height == h && variant == v && assembly == asmId; }
+
+    Algorithm::Id algo;
+    uint64_t height;
+    CnRCache::Variant variant;
+    Assembly::Id assembly;
+    size_t size;
+    uint8_t code[kMaxSize];
+};
+
+
+// Published programs are immutable, readers only do atomic loads, the mutex serializes compilation.
+static std::shared_ptr<const CnRProgram> slots[kSlots];
+static std::atomic<uint32_t> seen{0};
+static std::mutex mutex;
+static size_t cursor = 0;
+
+
+static std::shared_ptr<const CnRProgram> find(Algorithm::Id algo, uint64_t height, CnRCache::Variant variant, Assembly::Id assembly)
+{
+    for (auto &slot : slots) {
+        auto program = std::atomic_load(&slot);
+        if (program && program->match(algo, height, variant, assembly)) {
+            return program;
+        }
+    }
+
+    return {};
+}
+
+
+static std::shared_ptr<const CnRProgram> compile(Algorithm::Id algo, uint64_t height, CnRCache::Variant variant, Assembly::Id assembly)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto program = find(algo, height, variant, assembly);
+    if (program) {
+        return program;
+    }
+
+    auto p      = std::make_shared<CnRProgram>();
+    p->algo     = algo;
+    p->height   = height;
+    p->variant  = variant;
+    p->assembly = assembly;
+
+    V4_Instruction code[256];
+    const int code_size = v4_random_math_init<Algorithm::CN_R>(code, height);
+
+    switch (variant) {
+    case CnRCache::DOUBLE:
+        p->size = v4_compile_code_double(code, code_size, p->code, assembly);
+        break;
+
+    case CnRCache::SOFT_AES:
+        p->size = v4_soft_aes_compile_code(code, code_size, p->code, assembly);
+        break;
+
+    default:
+        p->size = v4_compile_code(code, code_size, p->code, assembly);
+        break;
+    }
+
+    program = p;
+    std::atomic_store(&slots[cursor++ % kSlots], program);
+
+    return program;
+}
+
+
+static inline std::shared_ptr<const CnRProgram> get(Algorithm::Id algo, uint64_t height, CnRCache::Variant variant, Assembly::Id assembly)
+{
+    auto program = find(algo, height, variant, assembly);
+
+    return program ? program : compile(algo, height, variant, assembly);
+}
+
+
+} // namespace xmrig
+
+
+void xmrig::CnRCache::copy(Algorithm::Id algo, uint64_t height, Variant variant, Assembly::Id assembly, void *machine_code)
+{
+    const uint32_t bit = 1U << (variant * Assembly::MAX + assembly);
+    if ((seen.load(std::memory_order_relaxed) & bit) == 0) {
+        seen.fetch_or(bit);
+    }
+
+    const auto program = get(algo, height, variant, assembly);
+
+    memcpy(machine_code, program->code, program->size);
+    VirtualMemory::flushInstructionCache(machine_code, program->size);
+}
+
+
+void xmrig::CnRCache::prefetch(Algorithm::Id algo, uint64_t height)
+{
+    if (algo != Algorithm::CN_R) {
+        return;
+    }
+
+    const uint32_t mask = seen.load();
+
+    for (uint32_t i = 0; i < VARIANT_MAX * Assembly::MAX; ++i) {
+        if (mask & (1U << i)) {
+            const auto variant  = static_cast<Variant>(i / Assembly::MAX);
+            const auto assembly = static_cast<Assembly::Id>(i % Assembly::MAX);
+
+            get(algo, height, variant, assembly);
+            get(algo, height + 1, variant, assembly);
+        }
+    }
+}
@@ -0,0 +1,54 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef XMRIG_CNRCACHE_H
+#define XMRIG_CNRCACHE_H
+
+
+#include <cstddef>
+#include <cstdint>
+
+
+#include "base/crypto/Algorithm.h"
+#include "crypto/common/Assembly.h"
+
+
+namespace xmrig
+{
+
+
+class CnRCache
+{
+public:
+    enum Variant : uint32_t {
+        SINGLE,
+        DOUBLE,
+        SOFT_AES,
+        VARIANT_MAX
+    };
+
+    static void copy(Algorithm::Id algo, uint64_t height, Variant variant, Assembly::Id assembly, void *machine_code);
+    static void prefetch(Algorithm::Id algo, uint64_t height);
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_CNRCACHE_H */
@@ -99,7 +99,7 @@ static inline void add_random_math(uint8_t* &p, const V4_Instruction* code, int
     }
 }
 
-void v4_compile_code(const V4_Instruction* code, int code_size, void* machine_code, xmrig::Assembly ASM)
+size_t v4_compile_code(const V4_Instruction* code, int code_size, void* machine_code, xmrig::Assembly ASM)
 {
     uint8_t* p0 = reinterpret_cast<uint8_t*>(machine_code);
     uint8_t* p = p0;
@@ -111,9 +111,11 @@ void v4_compile_code(const V4_Instruction* code, int code_size, void* machine_co
     add_code(p, CryptonightR_template_part3, CryptonightR_template_end);
 
     xmrig::VirtualMemory::flushInstructionCache(machine_code, p - p0);
+
+    return static_cast<size_t>(p - p0);
 }
 
-void v4_compile_code_double(const V4_Instruction* code, int code_size, void* machine_code, xmrig::Assembly ASM)
+size_t v4_compile_code_double(const V4_Instruction* code, int code_size, void* machine_code, xmrig::Assembly ASM)
 {
     uint8_t* p0 = reinterpret_cast<uint8_t*>(machine_code);
     uint8_t* p = p0;
@@ -127,9 +129,11 @@ void v4_compile_code_double(const V4_Instruction* code, int code_size, void* mac
     add_code(p, CryptonightR_template_double_part4, CryptonightR_template_double_end);
 
     xmrig::VirtualMemory::flushInstructionCache(machine_code, p - p0);
+
+    return static_cast<size_t>(p - p0);
 }
 
-void v4_soft_aes_compile_code(const V4_Instruction* code, int code_size, void* machine_code, xmrig::Assembly ASM)
+size_t v4_soft_aes_compile_code(const V4_Instruction* code, int code_size, void* machine_code, xmrig::Assembly ASM)
 {
     uint8_t* p0 = reinterpret_cast<uint8_t*>(machine_code);
     uint8_t* p = p0;
@@ -141,4 +145,6 @@ void v4_soft_aes_compile_code(const V4_Instruction* code, int code_size, void* m
     add_code(p, CryptonightR_soft_aes_template_part3, CryptonightR_soft_aes_template_end);
 
     xmrig::VirtualMemory::flushInstructionCache(machine_code, p - p0);
+
+    return static_cast<size_t>(p - p0);
 }
@@ -29,19 +29,24 @@
 #include "crypto/common/VirtualMemory.h"
 
 
+#include <algorithm>
 #include <cassert>
 
 
 namespace xmrig {
 
 
-constexpr size_t pageSize = 2 * 1024 * 1024;
+constexpr size_t pageSize       = 2 * 1024 * 1024;
+constexpr size_t blockAlignment = 64 * 1024;
+constexpr size_t maxGrowSize    = 256 * 1024 * 1024;
 
 
 } // namespace xmrig
 
 
-xmrig::MemoryPool::MemoryPool(size_t size, bool hugePages, uint32_t node)
+xmrig::MemoryPool::MemoryPool(size_t size, bool hugePages, uint32_t node) :
+    m_hugePages(hugePages),
+    m_node(node)
 {
     if (!size) {
         return;
@@ -49,50 +54,134 @@ xmrig::MemoryPool::MemoryPool(size_t size, bool hugePages, uint32_t node)
 
     constexpr size_t alignment = 1 << 24;
 
-    m_memory = new VirtualMemory(size * pageSize + alignment, hugePages, false, false, node);
+    auto memory = new VirtualMemory(size * pageSize + alignment, hugePages, false, false, node);
 
-    m_alignOffset = (alignment - (((size_t)m_memory->scratchpad()) % alignment)) % alignment;
+    // Don't mix page types inside the arena, all further chunks follow the reserved one.
+    m_hugePages = memory->isHugePages();
+
+    add(memory, (alignment - (((size_t)memory->scratchpad()) % alignment)) % alignment);
 }
 
 
 xmrig::MemoryPool::~MemoryPool()
 {
-    delete m_memory;
+    for (auto memory : m_chunks) {
+        delete memory;
+    }
 }
 
 
 bool xmrig::MemoryPool::isHugePages(uint32_t) const
 {
-    return m_memory && m_memory->isHugePages();
+    return m_hugePages;
+}
+
+
+size_t xmrig::MemoryPool::capacity() const
+{
+    return m_capacity;
+}
+
+
+size_t xmrig::MemoryPool::used() const
+{
+    return m_used;
 }
 
 
 uint8_t *xmrig::MemoryPool::get(size_t size, uint32_t)
 {
-    assert(!(size % pageSize));
+    size = VirtualMemory::align(size, blockAlignment);
+
+    // Best fit, the lowest address wins on a tie so scratchpads stay packed at the start of the arena.
+    auto block = m_free.end();
+    for (auto it = m_free.begin(); it != m_free.end(); ++it) {
+        if (it->second >= size && (block == m_free.end() || it->second < block->second)) {
+            block = it;
+        }
+    }
+
+    if (block == m_free.end()) {
+        if (!grow(size)) {
+            return nullptr;
+        }
 
-    if (!m_memory || (m_memory->size() - m_offset - m_alignOffset) < size) {
-        return nullptr;
+        return get(size, m_node);
     }
 
-    uint8_t *out = m_memory->scratchpad() + m_alignOffset + m_offset;
+    uint8_t *out = block->first;
+    if (block->second > size) {
+        m_free.insert({ out + size, block->second - size });
+    }
 
-    m_offset += size;
-    ++m_refs;
+    m_free.erase(block);
+    m_blocks.insert({ out, size });
+    m_used += size;
 
     return out;
 }
 
 
-void xmrig::MemoryPool::release(uint32_t)
+void xmrig::MemoryPool::release(uint8_t *ptr, uint32_t)
+{
+    const auto block = m_blocks.find(ptr);
+
+    assert(block != m_blocks.end());
+
+    if (block == m_blocks.end()) {
+        return;
+    }
+
+    size_t size = block->second;
+    m_used -= size;
+    m_blocks.erase(block);
+
+    auto next = m_free.find(ptr + size);
+    if (next != m_free.end()) {
+        size += next->second;
+        m_free.erase(next);
+    }
+
+    auto prev = m_free.lower_bound(ptr);
+    if (prev != m_free.begin() && (--prev)->first + prev->second == ptr) {
+        prev->second += size;
+        return;
+    }
+
+    m_free.insert({ ptr, size });
+}
+
+
+bool xmrig::MemoryPool::grow(size_t size)
 {
-    assert(m_refs > 0);
+    // Geometric growth keeps the number of chunks (and partially used huge pages) low when workers start one by one.
+    // Chunks stay far below 1 GB, so they always use regular 2 MB huge pages.
+    const size_t chunkSize = VirtualMemory::align(std::max(size, std::min(m_capacity, maxGrowSize)), pageSize);
+
+    auto memory = new VirtualMemory(chunkSize, m_hugePages, false, false, m_node);
+    if (!memory->scratchpad() || (m_hugePages && !memory->isHugePages())) {
+        delete memory;
 
-    if (m_refs > 0) {
-        --m_refs;
+        return false;
     }
 
-    if (m_refs == 0) {
-        m_offset = 0;
+    add(memory, 0);
+
+    return true;
+}
+
+
+void xmrig::MemoryPool::add(VirtualMemory *memory, size_t offset)
+{
+    if (!memory->scratchpad() || memory->capacity() <= offset) {
+        delete memory;
+
+        return;
     }
+
+    const size_t size = memory->capacity() - offset;
+
+    m_chunks.emplace_back(memory);
+    m_free.insert({ memory->scratchpad() + offset, size });
+    m_capacity += size;
 }
@@ -32,6 +32,10 @@
 #include "base/tools/Object.h"
 
 
+#include <map>
+#include <vector>
+
+
 namespace xmrig {
 
 
@@ -48,14 +52,22 @@ public:
 
 protected:
     bool isHugePages(uint32_t node) const override;
+    size_t capacity() const override;
+    size_t used() const override;
     uint8_t *get(size_t size, uint32_t node) override;
-    void release(uint32_t node) override;
+    void release(uint8_t *ptr, uint32_t node) override;
 
 private:
-    size_t m_refs           = 0;
-    size_t m_offset         = 0;
-    size_t m_alignOffset    = 0;
-    VirtualMemory *m_memory = nullptr;
+    bool grow(size_t size);
+    void add(VirtualMemory *memory, size_t offset);
+
+    bool m_hugePages        = true;
+    size_t m_capacity       = 0;
+    size_t m_used           = 0;
+    std::map<uint8_t *, size_t> m_free;
+    std::map<uint8_t *, size_t> m_blocks;
+    std::vector<VirtualMemory *> m_chunks;
+    uint32_t m_node         = 0;
 };
 
 
@@ -36,8 +36,7 @@
 
 xmrig::NUMAMemoryPool::NUMAMemoryPool(size_t size, bool hugePages) :
     m_hugePages(hugePages),
-    m_nodeSize(std::max<size_t>(size / Cpu::info()->nodes(), 1)),
-    m_size(size)
+    m_nodeSize(size ? std::max<size_t>(size / Cpu::info()->nodes(), 1) : 0)
 {
 }
 
@@ -52,29 +51,43 @@ xmrig::NUMAMemoryPool::~NUMAMemoryPool()
 
 bool xmrig::NUMAMemoryPool::isHugePages(uint32_t node) const
 {
-    if (!m_size) {
-        return false;
+    return getOrCreate(node)->isHugePages(node);
+}
+
+
+size_t xmrig::NUMAMemoryPool::capacity() const
+{
+    size_t out = 0;
+    for (const auto &kv : m_map) {
+        out += kv.second->capacity();
     }
 
-    return getOrCreate(node)->isHugePages(node);
+    return out;
 }
 
 
-uint8_t *xmrig::NUMAMemoryPool::get(size_t size, uint32_t node)
+size_t xmrig::NUMAMemoryPool::used() const
 {
-    if (!m_size) {
-        return nullptr;
+    size_t out = 0;
+    for (const auto &kv : m_map) {
+        out += kv.second->used();
     }
 
+    return out;
+}
+
+
+uint8_t *xmrig::NUMAMemoryPool::get(size_t size, uint32_t node)
+{
     return getOrCreate(node)->get(size, node);
 }
 
 
-void xmrig::NUMAMemoryPool::release(uint32_t node)
+void xmrig::NUMAMemoryPool::release(uint8_t *ptr, uint32_t node)
 {
     const auto pool = get(node);
     if (pool) {
-        pool->release(node);
+        pool->release(ptr, node);
     }
 }
 
@@ -51,8 +51,10 @@ public:
 
 protected:
     bool isHugePages(uint32_t node) const override;
+    size_t capacity() const override;
+    size_t used() const override;
     uint8_t *get(size_t size, uint32_t node) override;
-    void release(uint32_t node) override;
+    void release(uint8_t *ptr, uint32_t node) override;
 
 private:
     IMemoryPool *get(uint32_t node) const;
@@ -60,7 +62,6 @@ private:
 
     bool m_hugePages        = true;
     size_t m_nodeSize       = 0;
-    size_t m_size           = 0;
     mutable std::map<uint32_t, IMemoryPool *> m_map;
 };
 
@@ -20,11 +20,35 @@
 #include "crypto/common/Nonce.h"
 
 
+#include <algorithm>
+#include <mutex>
+
+
 namespace xmrig {
 
+
+constexpr size_t kMaxNodes          = 64;
+constexpr uint64_t kLeasesPerBlock  = 16;
+
+
+// Nonce range owned by one NUMA node, thread leases are carved from it without touching the global counter.
+struct alignas(64) NonceBlock
+{
+    std::mutex mutex;
+    uint64_t epoch  = 0;
+    uint64_t next   = 0;
+    uint64_t end    = 0;
+};
+
+
+static NonceBlock blocks[2][kMaxNodes];
+
+
 std::atomic<bool> Nonce::m_paused = {true};
 std::atomic<uint64_t>  Nonce::m_sequence[Nonce::MAX] = { {1}, {1}, {1} };
 std::atomic<uint64_t> Nonce::m_nonces[2] = { {0}, {0} };
+std::atomic<uint64_t> Nonce::m_epoch[2] = { {1}, {1} };
+std::atomic<uint64_t> Nonce::m_reserved = {0};
 
 
 } // namespace xmrig
@@ -37,30 +61,62 @@ bool xmrig::Nonce::next(uint8_t index, uint32_t *nonce, uint32_t reserveCount, u
         return false;
     }
 
-    uint64_t counter = m_nonces[index].fetch_add(reserveCount, std::memory_order_relaxed);
     while (true) {
-        if (mask < counter) {
+        switch (lease(m_nonces[index].fetch_add(reserveCount, std::memory_order_relaxed), nonce, reserveCount, mask)) {
+        case LEASE_OK:
+            return true;
+
+        case LEASE_FAILED:
             return false;
-        }
 
-        if (mask - counter <= reserveCount - 1) {
-            pause(true);
-            if (mask - counter < reserveCount - 1) {
-                return false;
-            }
-        }
-        else if (0xFFFFFFFFUL - (uint32_t)counter < reserveCount - 1) {
-            counter = m_nonces[index].fetch_add(reserveCount, std::memory_order_relaxed);
-            continue;
+        default:
+            break;
         }
+    }
+}
+
+
+bool xmrig::Nonce::next(uint8_t index, uint32_t *nonce, uint32_t *reserveCount, uint64_t mask, uint32_t node)
+{
+    mask &= 0x7FFFFFFFFFFFFFFFULL;
+    if (*reserveCount == 0 || mask < *reserveCount - 1) {
+        return false;
+    }
 
-        writeUnaligned(nonce, static_cast<uint32_t>((readUnaligned(nonce) & ~mask) | counter));
+    // Narrow nonce spaces (NiceHash) must still leave a share for every node.
+    const uint64_t blockSize = std::max<uint64_t>(*reserveCount, std::min<uint64_t>(*reserveCount * kLeasesPerBlock, (mask >> 8) + 1));
+    NonceBlock &block        = blocks[index][node % kMaxNodes];
 
-        if (mask > 0xFFFFFFFFULL) {
-            writeUnaligned(nonce + 1, static_cast<uint32_t>((readUnaligned(nonce + 1) & (~mask >> 32)) | (counter >> 32)));
+    std::lock_guard<std::mutex> lock(block.mutex);
+
+    while (true) {
+        // Read under the lock, an epoch loaded before it may already be stale when another thread refilled the block.
+        const uint64_t epoch = m_epoch[index].load(std::memory_order_acquire);
+
+        // The block that crosses the end of nonce space is kept, lease() detects exhaustion and pauses mining.
+        if (block.epoch != epoch || (block.end <= mask && block.next >= block.end)) {
+            block.next  = m_nonces[index].fetch_add(blockSize, std::memory_order_relaxed);
+            block.end   = block.next + blockSize;
+            block.epoch = epoch;
         }
 
-        return true;
+        // The rest of a block shorter than the lease is handed out as a short lease, leases differ per thread
+        // and dropping the rest would waste a large part of a narrow nonce space.
+        const uint64_t counter = block.next;
+        const uint32_t count   = block.end <= mask ? static_cast<uint32_t>(std::min<uint64_t>(*reserveCount, block.end - block.next)) : *reserveCount;
+        block.next += count;
+
+        switch (lease(counter, nonce, count, mask)) {
+        case LEASE_OK:
+            *reserveCount = count;
+            return true;
+
+        case LEASE_FAILED:
+            return false;
+
+        default:
+            break;
+        }
     }
 }
 
@@ -81,3 +137,29 @@ void xmrig::Nonce::touch()
         i++;
     }
 }
+
+
+xmrig::Nonce::Lease xmrig::Nonce::lease(uint64_t counter, uint32_t *nonce, uint32_t reserveCount, uint64_t mask)
+{
+    if (mask < counter) {
+        return LEASE_FAILED;
+    }
+
+    if (mask - counter <= reserveCount - 1) {
+        pause(true);
+        if (mask - counter < reserveCount - 1) {
+            return LEASE_FAILED;
+        }
+    }
+    else if (0xFFFFFFFFUL - (uint32_t)counter < reserveCount - 1) {
+        return LEASE_SKIP;
+    }
+
+    writeUnaligned(nonce, static_cast<uint32_t>((readUnaligned(nonce) & ~mask) | counter));
+
+    if (mask > 0xFFFFFFFFULL) {
+        writeUnaligned(nonce + 1, static_cast<uint32_t>((readUnaligned(nonce + 1) & (~mask >> 32)) | (counter >> 32)));
+    }
+
+    return LEASE_OK;
+}
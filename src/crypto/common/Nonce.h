@@ -41,18 +41,30 @@ public:
     static inline bool isPaused()                                       { return m_paused.load(std::memory_order_relaxed); }
     static inline uint64_t sequence(Backend backend)                    { return m_sequence[backend].load(std::memory_order_relaxed); }
     static inline void pause(bool paused)                               { m_paused = paused; }
-    static inline void reset(uint8_t index)                             { m_nonces[index] = 0; }
+    static inline uint64_t reserved()                                   { return m_reserved.load(std::memory_order_relaxed) + m_nonces[0].load(std::memory_order_relaxed) + m_nonces[1].load(std::memory_order_relaxed); }
+    static inline void reset(uint8_t index)                             { m_reserved += m_nonces[index].exchange(0); m_epoch[index]++; }
     static inline void stop(Backend backend)                            { m_sequence[backend] = 0; }
     static inline void touch(Backend backend)                           { m_sequence[backend]++; }
 
     static bool next(uint8_t index, uint32_t *nonce, uint32_t reserveCount, uint64_t mask);
+    static bool next(uint8_t index, uint32_t *nonce, uint32_t *reserveCount, uint64_t mask, uint32_t node);
     static void stop();
     static void touch();
 
 private:
+    enum Lease {
+        LEASE_OK,
+        LEASE_SKIP,
+        LEASE_FAILED
+    };
+
+    static Lease lease(uint64_t counter, uint32_t *nonce, uint32_t reserveCount, uint64_t mask);
+
+    static std::atomic<uint64_t> m_epoch[2];
     static std::atomic<bool> m_paused;
     static std::atomic<uint64_t> m_sequence[MAX];
     static std::atomic<uint64_t> m_nonces[2];
+    static std::atomic<uint64_t> m_reserved;
 };
 
 
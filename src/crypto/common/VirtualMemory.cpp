@@ -56,7 +56,7 @@ xmrig::VirtualMemory::VirtualMemory(size_t size, bool hugePages, bool oneGbPages
             return;
         }
 
-        m_scratchpad = pool->get(m_size, node);
+        m_scratchpad = pool->get(size, node);
         if (m_scratchpad) {
             m_flags.set(FLAG_HUGEPAGES, pool->isHugePages(node));
             m_flags.set(FLAG_EXTERNAL,  true);
@@ -86,7 +86,7 @@ xmrig::VirtualMemory::~VirtualMemory()
 
     if (m_flags.test(FLAG_EXTERNAL)) {
         std::lock_guard<std::mutex> lock(mutex);
-        pool->release(m_node);
+        pool->release(m_scratchpad, m_node);
     }
     else if (isHugePages() || isOneGbPages()) {
         freeLargePagesMemory();
@@ -111,6 +111,14 @@ uint32_t xmrig::VirtualMemory::bindToNUMANode(int64_t)
 #endif
 
 
+std::pair<size_t, size_t> xmrig::VirtualMemory::poolUsage()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    return pool ? std::pair<size_t, size_t>(pool->used(), pool->capacity()) : std::pair<size_t, size_t>(0, 0);
+}
+
+
 void xmrig::VirtualMemory::destroy()
 {
     delete pool;
@@ -119,13 +127,16 @@ void xmrig::VirtualMemory::destroy()
 
 void xmrig::VirtualMemory::init(size_t poolSize, size_t hugePageSize)
 {
-    if (!pool) {
-        osInit(hugePageSize);
+    // The huge page size may be set later by an algorithm that needs it (GhostRider), only the pool is created once.
+    osInit(hugePageSize);
+
+    if (pool) {
+        return;
     }
 
 #   ifdef XMRIG_FEATURE_HWLOC
     if (Cpu::info()->nodes() > 1) {
-        pool = new NUMAMemoryPool(align(poolSize, Cpu::info()->nodes()), hugePageSize > 0);
+        pool = new NUMAMemoryPool(poolSize ? align(poolSize, Cpu::info()->nodes()) : 0, hugePageSize > 0);
     } else
 #   endif
     {
@@ -68,6 +68,7 @@ public:
     static void destroy();
     static void flushInstructionCache(void *p, size_t size);
     static void freeLargePagesMemory(void *p, size_t size);
+    static std::pair<size_t, size_t> poolUsage();
     static void init(size_t poolSize, size_t hugePageSize);
 
     static inline constexpr size_t align(size_t pos, size_t align = kDefaultHugePageSize)   { return ((pos - 1) / align + 1) * align; }
@@ -22,7 +22,10 @@
 #include "backend/cpu/CpuConfig.h"
 #include "backend/cpu/CpuThreads.h"
 #include "crypto/rx/RxConfig.h"
+#include "crypto/rx/RxDatasetStore.h"
+#include "crypto/rx/RxInitPool.h"
 #include "crypto/rx/RxQueue.h"
+#include "crypto/rx/RxVm.h"
 #include "crypto/randomx/randomx.h"
 #include "crypto/randomx/aes_hash.hpp"
 
@@ -55,6 +58,12 @@ public:
 } // namespace xmrig
 
 
+bool xmrig::Rx::isPending()
+{
+    return d_ptr->queue.isPending();
+}
+
+
 xmrig::HugePagesInfo xmrig::Rx::hugePages()
 {
     return d_ptr->queue.hugePages();
@@ -69,6 +78,8 @@ xmrig::RxDataset *xmrig::Rx::dataset(const Job &job, uint32_t nodeId)
 
 void xmrig::Rx::destroy()
 {
+    RxVm::releaseAll();
+
 #   ifdef XMRIG_FEATURE_MSR
     RxMsr::destroy();
 #   endif
@@ -76,6 +87,8 @@ void xmrig::Rx::destroy()
     delete d_ptr;
 
     d_ptr = nullptr;
+
+    RxInitPool::destroy();
 }
 
 
@@ -85,6 +98,16 @@ void xmrig::Rx::init(IRxListener *listener)
 }
 
 
+void xmrig::Rx::precompute(const Job &job, const RxConfig &config, const CpuConfig &cpu)
+{
+    if (!config.isPrecompute() || config.mode() == RxConfig::LightMode || job.algorithm().family() != Algorithm::RANDOM_X || job.nextSeed().empty()) {
+        return;
+    }
+
+    d_ptr->queue.precompute(RxSeed(job.algorithm(), job.nextSeed()), config.nodeset(), config.precomputeThreads(cpu.limit()), cpu.isHugePages(), config.isOneGbPages(), config.mode(), 0);
+}
+
+
 #include "crypto/randomx/blake2/blake2.h"
 #if defined(XMRIG_FEATURE_AVX2)
 #include "crypto/randomx/blake2/avx2/blake2b.h"
@@ -135,6 +158,7 @@ bool xmrig::Rx::init(const T &seed, const RxConfig &config, const CpuConfig &cpu
     randomx_set_scratchpad_prefetch_mode(config.scratchpadPrefetchMode());
     randomx_set_huge_pages_jit(cpu.isHugePagesJit());
     randomx_set_optimized_dataset_init(config.initDatasetAVX2());
+    RxDatasetStore::setConfig(config.datasetCache(), config.datasetCacheMax());
 
     if (!osInitialized) {
 #       ifdef XMRIG_FIX_RYZEN
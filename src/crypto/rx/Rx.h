@@ -45,10 +45,12 @@ class RxDataset;
 class Rx
 {
 public:
+    static bool isPending();
     static HugePagesInfo hugePages();
     static RxDataset *dataset(const Job &job, uint32_t nodeId);
     static void destroy();
     static void init(IRxListener *listener);
+    static void precompute(const Job &job, const RxConfig &config, const CpuConfig &cpu);
     template<typename T> static bool init(const T &seed, const RxConfig &config, const CpuConfig &cpu);
     template<typename T> static bool isReady(const T &seed);
 
@@ -29,6 +29,12 @@
 #include "crypto/rx/RxSeed.h"
 
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <uv.h>
+
+
 namespace xmrig {
 
 
@@ -41,19 +47,40 @@ public:
     XMRIG_DISABLE_COPY_MOVE(RxBasicStoragePrivate)
 
     inline RxBasicStoragePrivate() = default;
-    inline ~RxBasicStoragePrivate() { deleteDataset(); }
+    inline ~RxBasicStoragePrivate() { deleteDataset(); delete m_next; }
 
     inline bool isReady(const Job &job) const   { return m_ready && m_seed == job; }
     inline RxDataset *dataset() const           { return m_dataset; }
     inline void deleteDataset()                 { delete m_dataset; m_dataset = nullptr; }
 
 
+    inline HugePagesInfo nextHugePages()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        return m_next ? m_next->hugePages() : HugePagesInfo();
+    }
+
+
     inline void setSeed(const RxSeed &seed)
     {
         m_ready = false;
 
         if (m_seed.algorithm() != seed.algorithm()) {
-            RxAlgo::apply(seed.algorithm());
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            // Dataset parameters are global and an in-flight precompute reads them, wait for it before they change
+            m_nextReady = false;
+            ++m_generation;
+
+            if (m_precomputing) {
+                LOG_INFO("%s" YELLOW("waiting for next dataset precompute to finish before algorithm switch"), Tags::randomx());
+
+                m_precomputed.wait(lock, [this] { return !m_precomputing; });
+            }
+
+            m_algorithm = seed.algorithm();
+            RxAlgo::apply(m_algorithm);
         }
 
         m_seed = seed;
@@ -79,11 +106,106 @@ public:
     }
 
 
+    inline bool swapDataset()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (!m_nextReady || m_nextSeed != m_seed || !m_dataset || !m_dataset->get()) {
+            return false;
+        }
+
+        // The previous dataset is kept as the next spare buffer, VMs may still reference its scratchpads
+        std::swap(m_dataset, m_next);
+        m_nextReady = false;
+        m_ready     = true;
+
+        LOG_INFO("%s" GREEN_BOLD("dataset ready") BLACK_BOLD(" (precomputed)"), Tags::randomx());
+
+        return true;
+    }
+
+
+    inline bool precompute(const RxSeed &seed, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        if (m_nextReady && m_nextSeed == seed) {
+            return true;
+        }
+
+        // The next seed needs other dataset parameters, precompute can't run without changing them under the miner
+        if (seed.algorithm() != m_algorithm) {
+            return true;
+        }
+
+        // Only the precompute thread creates the spare dataset, allocate it outside of the lock
+        if (!m_next) {
+            lock.unlock();
+
+            RxDataset *next = createNext(hugePages, oneGbPages, mode);
+            if (!next) {
+                return false;
+            }
+
+            lock.lock();
+            m_next = next;
+
+            if (seed.algorithm() != m_algorithm) {
+                return true;
+            }
+        }
+
+        // After a swap the spare is the previous dataset, VMs still hashing an old job read it until their workers pick up the new seed
+        m_nextReady = false;
+
+        if (m_next->hasUsers()) {
+            LOG_INFO("%s" YELLOW("waiting for workers to release the previous dataset"), Tags::randomx());
+
+            do {
+                lock.unlock();
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                lock.lock();
+
+                if (seed.algorithm() != m_algorithm) {
+                    return true;
+                }
+            }
+            while (m_next->hasUsers());
+        }
+
+        const uint64_t generation = m_generation;
+        RxDataset *next           = m_next;
+        m_nextSeed                = seed;
+        m_precomputing            = true;
+
+        lock.unlock();
+
+        const uint64_t ts = Chrono::steadyMSecs();
+        const bool ready  = next->init(seed, threads, priority);
+
+        lock.lock();
+
+        m_precomputing = false;
+        m_nextReady    = ready && generation == m_generation;
+        m_precomputed.notify_all();
+
+        if (m_nextReady) {
+            LOG_INFO("%s" GREEN_BOLD("next dataset ready") BLACK_BOLD(" (%" PRIu64 " ms)"), Tags::randomx(), Chrono::steadyMSecs() - ts);
+        }
+
+        return true;
+    }
+
+
     inline void initDataset(uint32_t threads, int priority)
     {
+        if (swapDataset()) {
+            return;
+        }
+
         const uint64_t ts = Chrono::steadyMSecs();
 
-        m_ready = m_dataset->init(m_seed.data(), threads, priority);
+        m_ready = m_dataset->init(m_seed, threads, priority);
 
         if (m_ready) {
             LOG_INFO("%s" GREEN_BOLD("dataset ready") BLACK_BOLD(" (%" PRIu64 " ms)"), Tags::randomx(), Chrono::steadyMSecs() - ts);
@@ -92,6 +214,39 @@ public:
 
 
 private:
+    static RxDataset *createNext(bool hugePages, bool oneGbPages, RxConfig::Mode mode)
+    {
+        const uint64_t size = RxDataset::maxSize() + RxCache::maxSize();
+
+        if (!hugePages && uv_get_free_memory() < size + size / 4) {
+            LOG_WARN("%s" YELLOW_BOLD("not enough free memory to precompute next dataset"), Tags::randomx());
+
+            return nullptr;
+        }
+
+        auto next        = new RxDataset(hugePages, oneGbPages, true, mode, 0);
+        const auto pages = next->hugePages();
+
+        if (!next->get() || !next->cache()->get() || (hugePages && !pages.isFullyAllocated())) {
+            LOG_WARN("%s" YELLOW_BOLD("not enough %s to precompute next dataset"), Tags::randomx(), hugePages ? "huge pages" : "memory");
+
+            delete next;
+
+            return nullptr;
+        }
+
+        LOG_INFO("%s" GREEN_BOLD("allocated") CYAN_BOLD(" %zu MB") " for next dataset huge pages %1.0f%% %u/%u",
+                 Tags::randomx(),
+                 pages.size / oneMiB,
+                 pages.percent(),
+                 pages.allocated,
+                 pages.total
+                 );
+
+        return next;
+    }
+
+
     void printAllocStatus(uint64_t ts)
     {
         if (m_dataset->get() != nullptr) {
@@ -116,9 +271,17 @@ private:
     }
 
 
-    bool m_ready         = false;
-    RxDataset *m_dataset = nullptr;
+    Algorithm m_algorithm;
+    bool m_nextReady        = false;
+    bool m_precomputing     = false;
+    bool m_ready            = false;
+    RxDataset *m_dataset    = nullptr;
+    RxDataset *m_next       = nullptr;
+    RxSeed m_nextSeed;
     RxSeed m_seed;
+    std::condition_variable m_precomputed;
+    std::mutex m_mutex;
+    uint64_t m_generation   = 0;
 };
 
 
@@ -143,13 +306,22 @@ bool xmrig::RxBasicStorage::isAllocated() const
 }
 
 
+bool xmrig::RxBasicStorage::precompute(const RxSeed &seed, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority)
+{
+    return d_ptr->precompute(seed, threads, hugePages, oneGbPages, mode, priority);
+}
+
+
 xmrig::HugePagesInfo xmrig::RxBasicStorage::hugePages() const
 {
     if (!d_ptr->dataset()) {
         return {};
     }
 
-    return d_ptr->dataset()->hugePages();
+    auto pages = d_ptr->dataset()->hugePages();
+    pages += d_ptr->nextHugePages();
+
+    return pages;
 }
 
 
@@ -39,10 +39,14 @@ const char *RxConfig::kInitAVX2                 = "init-avx2";
 const char *RxConfig::kField                    = "randomx";
 const char *RxConfig::kMode                     = "mode";
 const char *RxConfig::kOneGbPages               = "1gb-pages";
+const char *RxConfig::kPrecompute               = "precompute";
+const char *RxConfig::kPrecomputeThreads        = "precompute-threads";
 const char *RxConfig::kRdmsr                    = "rdmsr";
 const char *RxConfig::kWrmsr                    = "wrmsr";
 const char *RxConfig::kScratchpadPrefetchMode   = "scratchpad_prefetch_mode";
 const char *RxConfig::kCacheQoS                 = "cache_qos";
+const char *RxConfig::kDatasetCache             = "dataset-cache";
+const char *RxConfig::kDatasetCacheMax          = "dataset-cache-max";
 
 #ifdef XMRIG_FEATURE_HWLOC
 const char *RxConfig::kNUMA                     = "numa";
@@ -87,6 +91,12 @@ bool xmrig::RxConfig::read(const rapidjson::Value &value)
 
         m_cacheQoS = Json::getBool(value, kCacheQoS, m_cacheQoS);
 
+        m_datasetCache    = Json::getString(value, kDatasetCache);
+        m_datasetCacheMax = Json::getUint(value, kDatasetCacheMax, m_datasetCacheMax);
+
+        m_precompute        = Json::getBool(value, kPrecompute, m_precompute);
+        m_precomputeThreads = Json::getInt(value, kPrecomputeThreads, m_precomputeThreads);
+
 #       ifdef XMRIG_OS_LINUX
         m_oneGbPages = Json::getBool(value, kOneGbPages, m_oneGbPages);
 #       endif
@@ -156,6 +166,10 @@ rapidjson::Value xmrig::RxConfig::toJSON(rapidjson::Document &doc) const
 #   endif
 
     obj.AddMember(StringRef(kCacheQoS), m_cacheQoS, allocator);
+    obj.AddMember(StringRef(kDatasetCache), m_datasetCache.toJSON(), allocator);
+    obj.AddMember(StringRef(kDatasetCacheMax), m_datasetCacheMax, allocator);
+    obj.AddMember(StringRef(kPrecompute), m_precompute, allocator);
+    obj.AddMember(StringRef(kPrecomputeThreads), m_precomputeThreads, allocator);
 
 #   ifdef XMRIG_FEATURE_HWLOC
     if (!m_nodeset.empty()) {
@@ -196,6 +210,18 @@ const char *xmrig::RxConfig::modeName() const
 }
 
 
+uint32_t xmrig::RxConfig::precomputeThreads(uint32_t limit) const
+{
+    const uint32_t max = threads(limit);
+
+    if (m_precomputeThreads > 0) {
+        return std::min(static_cast<uint32_t>(m_precomputeThreads), max);
+    }
+
+    return std::max(max / 4, 1U);
+}
+
+
 uint32_t xmrig::RxConfig::threads(uint32_t limit) const
 {
     if (m_threads > 0) {
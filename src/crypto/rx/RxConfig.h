@@ -21,6 +21,7 @@
 
 
 #include "3rdparty/rapidjson/fwd.h"
+#include "base/tools/String.h"
 
 
 #ifdef XMRIG_FEATURE_MSR
@@ -53,11 +54,15 @@ public:
     };
 
     static const char *kCacheQoS;
+    static const char *kDatasetCache;
+    static const char *kDatasetCacheMax;
     static const char *kField;
     static const char *kInit;
     static const char *kInitAVX2;
     static const char *kMode;
     static const char *kOneGbPages;
+    static const char *kPrecompute;
+    static const char *kPrecomputeThreads;
     static const char *kRdmsr;
     static const char *kScratchpadPrefetchMode;
     static const char *kWrmsr;
@@ -76,15 +81,20 @@ public:
 #   endif
 
     const char *modeName() const;
+    uint32_t precomputeThreads(uint32_t limit = 100) const;
     uint32_t threads(uint32_t limit = 100) const;
 
     inline int initDatasetAVX2() const  { return m_initDatasetAVX2; }
     inline bool isOneGbPages() const    { return m_oneGbPages; }
+    inline bool isPrecompute() const    { return m_precompute; }
     inline bool rdmsr() const           { return m_rdmsr; }
     inline bool wrmsr() const           { return m_wrmsr; }
     inline bool cacheQoS() const        { return m_cacheQoS; }
     inline Mode mode() const            { return m_mode; }
 
+    inline const String &datasetCache() const   { return m_datasetCache; }
+    inline uint32_t datasetCacheMax() const     { return m_datasetCacheMax; }
+
     inline ScratchpadPrefetchMode scratchpadPrefetchMode() const { return m_scratchpadPrefetchMode; }
 
 #   ifdef XMRIG_FEATURE_MSR
@@ -108,10 +118,14 @@ private:
     static Mode readMode(const rapidjson::Value &value);
 
     bool m_oneGbPages     = false;
+    bool m_precompute     = false;
     bool m_rdmsr          = true;
+    int m_precomputeThreads = 1;
     int m_threads         = -1;
     int m_initDatasetAVX2 = -1;
     Mode m_mode           = AutoMode;
+    String m_datasetCache;
+    uint32_t m_datasetCacheMax = 2;
 
     ScratchpadPrefetchMode m_scratchpadPrefetchMode = ScratchpadPrefetchT0;
 
@@ -18,40 +18,20 @@
  */
 
 #include "crypto/rx/RxDataset.h"
-#include "backend/cpu/Cpu.h"
 #include "base/io/log/Log.h"
 #include "base/io/log/Tags.h"
-#include "base/kernel/Platform.h"
 #include "crypto/common/VirtualMemory.h"
 #include "crypto/randomx/randomx.h"
 #include "crypto/rx/RxAlgo.h"
 #include "crypto/rx/RxCache.h"
+#include "crypto/rx/RxDatasetStore.h"
+#include "crypto/rx/RxInitPool.h"
+#include "crypto/rx/RxSeed.h"
 
 
-#include <thread>
 #include <uv.h>
 
 
-namespace xmrig {
-
-
-static void init_dataset_wrapper(randomx_dataset *dataset, randomx_cache *cache, uint32_t startItem, uint32_t itemCount, int priority)
-{
-    Platform::setThreadPriority(priority);
-
-    if (Cpu::info()->hasAVX2() && (itemCount % 5)) {
-        randomx_init_dataset(dataset, cache, startItem, itemCount - (itemCount % 5));
-        randomx_init_dataset(dataset, cache, startItem + itemCount - 5, 5);
-    }
-    else {
-        randomx_init_dataset(dataset, cache, startItem, itemCount);
-    }
-}
-
-
-} // namespace xmrig
-
-
 xmrig::RxDataset::RxDataset(bool hugePages, bool oneGbPages, bool cache, RxConfig::Mode mode, uint32_t node) :
     m_mode(mode),
     m_node(node)
@@ -79,6 +59,8 @@ xmrig::RxDataset::RxDataset(RxCache *cache) :
 
 xmrig::RxDataset::~RxDataset()
 {
+    RxDatasetStore::wait(this);
+
     randomx_release_dataset(m_dataset);
 
     delete m_cache;
@@ -86,37 +68,27 @@ xmrig::RxDataset::~RxDataset()
 }
 
 
-bool xmrig::RxDataset::init(const Buffer &seed, uint32_t numThreads, int priority)
+bool xmrig::RxDataset::init(const RxSeed &seed, uint32_t numThreads, int priority)
 {
     if (!m_cache || !m_cache->get()) {
         return false;
     }
 
-    m_cache->init(seed);
+    RxDatasetStore::wait(this);
+
+    m_cache->init(seed.data());
 
     if (!get()) {
         return true;
     }
 
-    const uint64_t datasetItemCount = randomx_dataset_item_count();
-
-    if (numThreads > 1) {
-        std::vector<std::thread> threads;
-        threads.reserve(numThreads);
+    if (RxDatasetStore::load(seed, this)) {
+        return true;
+    }
 
-        for (uint64_t i = 0; i < numThreads; ++i) {
-            const uint32_t a = (datasetItemCount * i) / numThreads;
-            const uint32_t b = (datasetItemCount * (i + 1)) / numThreads;
-            threads.emplace_back(init_dataset_wrapper, m_dataset, m_cache->get(), a, b - a, priority);
-        }
+    RxInitPool::init(m_dataset, m_cache->get(), 0, static_cast<uint32_t>(randomx_dataset_item_count()), numThreads, priority);
 
-        for (uint32_t i = 0; i < numThreads; ++i) {
-            threads[i].join();
-        }
-    }
-    else {
-        init_dataset_wrapper(m_dataset, m_cache->get(), 0, datasetItemCount, priority);
-    }
+    RxDatasetStore::save(seed, this);
 
     return true;
 }
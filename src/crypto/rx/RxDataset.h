@@ -38,6 +38,7 @@ namespace xmrig
 
 
 class RxCache;
+class RxSeed;
 class VirtualMemory;
 
 
@@ -50,11 +51,14 @@ public:
     RxDataset(RxCache *cache);
     ~RxDataset();
 
+    inline bool hasUsers() const            { return m_users.load(std::memory_order_acquire) > 0; }
     inline randomx_dataset *get() const     { return m_dataset; }
     inline RxCache *cache() const           { return m_cache; }
+    inline void addUser()                   { m_users.fetch_add(1, std::memory_order_acq_rel); }
+    inline void removeUser()                { m_users.fetch_sub(1, std::memory_order_acq_rel); }
     inline void setCache(RxCache *cache)    { m_cache = cache; }
 
-    bool init(const Buffer &seed, uint32_t numThreads, int priority);
+    bool init(const RxSeed &seed, uint32_t numThreads, int priority);
     bool isHugePages() const;
     bool isOneGbPages() const;
     HugePagesInfo hugePages(bool cache = true) const;
@@ -74,6 +78,7 @@ private:
     RxCache *m_cache            = nullptr;
     size_t m_scratchpadLimit    = 0;
     std::atomic<size_t> m_scratchpadOffset{};
+    std::atomic<uint32_t> m_users{};
     VirtualMemory *m_memory     = nullptr;
 };
 
@@ -0,0 +1,293 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "crypto/rx/RxDatasetStore.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "base/tools/Chrono.h"
+#include "base/tools/Cvt.h"
+#include "crypto/randomx/dataset.hpp"
+#include "crypto/randomx/randomx.h"
+#include "crypto/rx/RxCache.h"
+#include "crypto/rx/RxDataset.h"
+#include "crypto/rx/RxSeed.h"
+
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <atomic>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <random>
+#include <thread>
+
+
+namespace xmrig {
+
+
+static const char kMagic[8]             = { 'X', 'M', 'R', 'I', 'G', 'R', 'X', 'D' };
+static const char *kExtension           = ".rxd";
+constexpr uint32_t kVersion             = 1;
+constexpr size_t kChunkSize             = 64 * 1024 * 1024;
+constexpr size_t kSamples               = 64;
+constexpr size_t oneMiB                 = 1024 * 1024;
+
+static std::atomic<bool> cancel(false);
+static std::condition_variable saved;
+static std::mutex mutex;
+static String storePath;
+static uint32_t storeMax                = 2;
+static const RxDataset *saving          = nullptr;
+
+
+struct RxDatasetHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t algorithm;
+    uint64_t items;
+    uint32_t seedSize;
+    uint8_t seed[60];
+};
+
+
+static_assert(sizeof(RxDatasetHeader) == 88, "RxDatasetHeader size mismatch");
+
+
+static inline RxDatasetHeader header(const RxSeed &seed)
+{
+    RxDatasetHeader h{};
+    memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.version   = kVersion;
+    h.algorithm = seed.algorithm().id();
+    h.items     = randomx_dataset_item_count();
+    h.seedSize  = static_cast<uint32_t>(std::min(seed.data().size(), sizeof(h.seed)));
+
+    memcpy(h.seed, seed.data().data(), h.seedSize);
+
+    return h;
+}
+
+
+static inline std::string fileName(const std::string &path, const RxSeed &seed)
+{
+    char algo[16];
+    snprintf(algo, sizeof(algo), "%08x-", static_cast<uint32_t>(seed.algorithm().id()));
+
+    return path + "/" + algo + Cvt::toHex(seed.data()).data() + kExtension;
+}
+
+
+static bool verify(const RxDataset *dataset, uint64_t items)
+{
+    auto cache      = dataset->cache()->get();
+    auto memory     = static_cast<const uint8_t *>(dataset->raw());
+
+    std::mt19937_64 rng(std::random_device{}());
+    alignas(64) uint8_t item[RANDOMX_DATASET_ITEM_SIZE];
+
+    for (size_t i = 0; i < kSamples; ++i) {
+        const uint64_t index = (i == 0) ? 0 : ((i == 1) ? items - 1 : rng() % items);
+
+        randomx::initDatasetItem(cache, item, index);
+
+        if (memcmp(item, memory + index * RANDOMX_DATASET_ITEM_SIZE, sizeof(item)) != 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+} // namespace xmrig
+
+
+bool xmrig::RxDatasetStore::isEnabled()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    return !storePath.isEmpty();
+}
+
+
+bool xmrig::RxDatasetStore::load(const RxSeed &seed, RxDataset *dataset)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    if (storePath.isEmpty() || !dataset->get() || !dataset->cache() || !dataset->cache()->get()) {
+        return false;
+    }
+
+    const std::string name = fileName(storePath.data(), seed);
+    lock.unlock();
+
+    std::ifstream file(name, std::ios::in | std::ios::binary);
+    if (!file.good()) {
+        return false;
+    }
+
+    const uint64_t ts           = Chrono::steadyMSecs();
+    const RxDatasetHeader ref   = header(seed);
+    RxDatasetHeader h{};
+
+    if (!file.read(reinterpret_cast<char *>(&h), sizeof(h)) || memcmp(&h, &ref, sizeof(h)) != 0) {
+        LOG_WARN("%s" YELLOW_BOLD("dataset file header mismatch, ignored"), Tags::randomx());
+
+        return false;
+    }
+
+    const uint64_t size = h.items * RANDOMX_DATASET_ITEM_SIZE;
+    auto memory         = static_cast<char *>(dataset->raw());
+
+    for (uint64_t offset = 0; offset < size; offset += kChunkSize) {
+        if (!file.read(memory + offset, static_cast<std::streamsize>(std::min<uint64_t>(kChunkSize, size - offset)))) {
+            LOG_WARN("%s" YELLOW_BOLD("dataset file is truncated, ignored"), Tags::randomx());
+
+            return false;
+        }
+    }
+
+    if (!verify(dataset, h.items)) {
+        LOG_WARN("%s" YELLOW_BOLD("dataset file verification failed, ignored"), Tags::randomx());
+
+        std::remove(name.c_str());
+
+        return false;
+    }
+
+    touch(name);
+
+    LOG_INFO("%s" GREEN_BOLD("dataset loaded from disk") CYAN_BOLD(" %" PRIu64 " MB") BLACK_BOLD(" (%" PRIu64 " ms)"), Tags::randomx(), size / oneMiB, Chrono::steadyMSecs() - ts);
+
+    return true;
+}
+
+
+void xmrig::RxDatasetStore::save(const RxSeed &seed, const RxDataset *dataset)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    if (storePath.isEmpty() || !dataset->get()) {
+        return;
+    }
+
+    // Only one save at a time, an unfinished save of an older dataset is not worth waiting for.
+    cancel = saving != nullptr;
+    saved.wait(lock, [] { return saving == nullptr; });
+
+    const std::string path = storePath.data();
+    const uint32_t max     = storeMax;
+
+    cancel = false;
+    saving = dataset;
+
+    // Mining resumes while the file is written, the dataset memory is only read.
+    std::thread([seed, dataset, path, max] {
+        write(seed, dataset, path, max);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        saving = nullptr;
+        saved.notify_all();
+    }).detach();
+}
+
+
+void xmrig::RxDatasetStore::setConfig(const String &path, uint32_t max)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    storePath = path;
+    storeMax  = std::max(max, 1U);
+}
+
+
+void xmrig::RxDatasetStore::wait(const RxDataset *dataset)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    if (saving != dataset) {
+        return;
+    }
+
+    cancel = true;
+    saved.wait(lock, [dataset] { return saving != dataset; });
+}
+
+
+void xmrig::RxDatasetStore::evict(const std::string &path, uint32_t max)
+{
+    auto files = entries(path);
+    if (files.size() <= max) {
+        return;
+    }
+
+    std::sort(files.begin(), files.end(), [](const Entry &a, const Entry &b) { return a.mtime > b.mtime; });
+
+    for (size_t i = max; i < files.size(); ++i) {
+        if (std::remove(files[i].path.c_str()) == 0) {
+            LOG_INFO("%s" WHITE_BOLD("evicted dataset file ") BLACK_BOLD("%s"), Tags::randomx(), files[i].path.c_str());
+        }
+    }
+}
+
+
+void xmrig::RxDatasetStore::write(const RxSeed &seed, const RxDataset *dataset, const std::string &path, uint32_t max)
+{
+    if (!createDirectory(path)) {
+        LOG_WARN("%s" YELLOW_BOLD("failed to create dataset directory \"%s\""), Tags::randomx(), path.c_str());
+
+        return;
+    }
+
+    const uint64_t ts           = Chrono::steadyMSecs();
+    const std::string name      = fileName(path, seed);
+    const std::string tmp       = name + ".tmp";
+    const RxDatasetHeader h     = header(seed);
+    const uint64_t size         = h.items * RANDOMX_DATASET_ITEM_SIZE;
+    auto memory                 = static_cast<const char *>(dataset->raw());
+
+    std::ofstream file(tmp, std::ios::out | std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char *>(&h), sizeof(h));
+
+    for (uint64_t offset = 0; offset < size && file.good() && !cancel; offset += kChunkSize) {
+        file.write(memory + offset, static_cast<std::streamsize>(std::min<uint64_t>(kChunkSize, size - offset)));
+    }
+
+    file.close();
+
+    if (cancel) {
+        std::remove(tmp.c_str());
+
+        return;
+    }
+
+    // Write to a temporary file first, a partially written dataset must never be visible under the final name.
+    std::remove(name.c_str());
+    if (file.fail() || std::rename(tmp.c_str(), name.c_str()) != 0) {
+        std::remove(tmp.c_str());
+
+        LOG_WARN("%s" YELLOW_BOLD("failed to save dataset to \"%s\""), Tags::randomx(), name.c_str());
+
+        return;
+    }
+
+    LOG_INFO("%s" GREEN_BOLD("dataset saved to disk") BLACK_BOLD(" (%" PRIu64 " ms)"), Tags::randomx(), Chrono::steadyMSecs() - ts);
+
+    evict(path, max);
+}
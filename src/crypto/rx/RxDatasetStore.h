@@ -0,0 +1,70 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_RX_DATASETSTORE_H
+#define XMRIG_RX_DATASETSTORE_H
+
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+#include "base/tools/String.h"
+
+
+namespace xmrig
+{
+
+
+class RxDataset;
+class RxSeed;
+
+
+// Optional on-disk store of initialized RandomX datasets, one file per seed and algorithm.
+// Files are streamed into the already allocated (huge pages backed) dataset memory and verified by
+// recomputing a random sample of items from the cache, least recently used files are evicted.
+// Saving runs on a background thread, wait() must be called before the dataset memory is rewritten or freed.
+class RxDatasetStore
+{
+public:
+    static bool isEnabled();
+    static bool load(const RxSeed &seed, RxDataset *dataset);
+    static void save(const RxSeed &seed, const RxDataset *dataset);
+    static void setConfig(const String &path, uint32_t max);
+    static void wait(const RxDataset *dataset);
+
+private:
+    struct Entry
+    {
+        std::string path;
+        int64_t mtime;
+    };
+
+    static bool createDirectory(const std::string &path);
+    static std::vector<Entry> entries(const std::string &path);
+    static void evict(const std::string &path, uint32_t max);
+    static void touch(const std::string &fileName);
+    static void write(const RxSeed &seed, const RxDataset *dataset, const std::string &path, uint32_t max);
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_RX_DATASETSTORE_H */
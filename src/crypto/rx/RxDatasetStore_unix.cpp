@@ -0,0 +1,68 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <cerrno>
+#include <cstring>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+
+
+#include "crypto/rx/RxDatasetStore.h"
+
+
+bool xmrig::RxDatasetStore::createDirectory(const std::string &path)
+{
+    return mkdir(path.c_str(), 0755) == 0 || errno == EEXIST;
+}
+
+
+std::vector<xmrig::RxDatasetStore::Entry> xmrig::RxDatasetStore::entries(const std::string &path)
+{
+    std::vector<Entry> out;
+
+    DIR *dir = opendir(path.c_str());
+    if (!dir) {
+        return out;
+    }
+
+    while (dirent *entry = readdir(dir)) {
+        const size_t size = strlen(entry->d_name);
+        if (size < 4 || strcmp(entry->d_name + size - 4, ".rxd") != 0) {
+            continue;
+        }
+
+        const std::string fileName = path + "/" + entry->d_name;
+
+        struct stat st{};
+        if (stat(fileName.c_str(), &st) == 0) {
+            out.push_back({ fileName, static_cast<int64_t>(st.st_mtime) });
+        }
+    }
+
+    closedir(dir);
+
+    return out;
+}
+
+
+void xmrig::RxDatasetStore::touch(const std::string &fileName)
+{
+    utimes(fileName.c_str(), nullptr);
+}
@@ -0,0 +1,69 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <direct.h>
+#include <cerrno>
+#include <windows.h>
+
+
+#include "crypto/rx/RxDatasetStore.h"
+
+
+bool xmrig::RxDatasetStore::createDirectory(const std::string &path)
+{
+    return _mkdir(path.c_str()) == 0 || errno == EEXIST;
+}
+
+
+std::vector<xmrig::RxDatasetStore::Entry> xmrig::RxDatasetStore::entries(const std::string &path)
+{
+    std::vector<Entry> out;
+
+    WIN32_FIND_DATAA data;
+    HANDLE h = FindFirstFileA((path + "\\*.rxd").c_str(), &data);
+    if (h == INVALID_HANDLE_VALUE) {
+        return out;
+    }
+
+    do {
+        ULARGE_INTEGER mtime;
+        mtime.LowPart  = data.ftLastWriteTime.dwLowDateTime;
+        mtime.HighPart = data.ftLastWriteTime.dwHighDateTime;
+
+        out.push_back({ path + "\\" + data.cFileName, static_cast<int64_t>(mtime.QuadPart) });
+    } while (FindNextFileA(h, &data));
+
+    FindClose(h);
+
+    return out;
+}
+
+
+void xmrig::RxDatasetStore::touch(const std::string &fileName)
+{
+    HANDLE h = CreateFileA(fileName.c_str(), FILE_WRITE_ATTRIBUTES, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (h == INVALID_HANDLE_VALUE) {
+        return;
+    }
+
+    FILETIME ft;
+    GetSystemTimeAsFileTime(&ft);
+    SetFileTime(h, nullptr, nullptr, &ft);
+    CloseHandle(h);
+}
@@ -0,0 +1,386 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "crypto/rx/RxInitPool.h"
+#include "backend/common/Profile.h"
+#include "backend/cpu/Cpu.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "base/kernel/Platform.h"
+#include "base/tools/Chrono.h"
+#include "base/tools/Object.h"
+#include "crypto/randomx/randomx.h"
+
+
+#ifdef XMRIG_FEATURE_HWLOC
+#   include <hwloc.h>
+#endif
+
+
+#include <algorithm>
+#include <atomic>
+#include <cinttypes>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace xmrig {
+
+
+// 2 MiB of dataset per chunk, so the shared cursor is touched about 1000 times per dataset.
+// Chunks don't place memory: pages are not bound to a node, and huge pages are already populated by the allocation.
+static constexpr uint32_t kChunkItems = 32768;
+
+
+class RxInitTask
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(RxInitTask)
+
+    inline RxInitTask(randomx_dataset *dataset, randomx_cache *cache, uint32_t startItem, uint32_t itemCount, uint32_t threads, int priority) :
+        m_dataset(dataset),
+        m_cache(cache),
+        m_priority(priority),
+        m_chunks(std::max(itemCount / kChunkItems, 1U)),
+        m_end(startItem + itemCount),
+        m_start(startItem),
+        m_stats(threads)
+    {}
+
+    inline uint32_t threads() const { return static_cast<uint32_t>(m_stats.size()); }
+
+
+    void run(uint32_t index, int64_t cpu)
+    {
+        Platform::setThreadPriority(m_priority);
+
+        ProfileSample sample(Profile::DATASET_INIT);
+
+        const double ts = Chrono::highResolutionMSecs();
+        uint32_t items  = 0;
+        uint32_t chunk  = 0;
+
+        // The last chunk takes the remainder, so no chunk is smaller than kChunkItems unless the whole range is
+        while ((chunk = m_next.fetch_add(1, std::memory_order_relaxed)) < m_chunks) {
+            const uint32_t a = m_start + chunk * kChunkItems;
+            const uint32_t b = (chunk == m_chunks - 1) ? m_end : (a + kChunkItems);
+
+            initItems(a, b - a);
+            items += b - a;
+        }
+
+        auto &stats = m_stats[index];
+        stats.cpu   = cpu;
+        stats.items = items;
+        stats.ms    = Chrono::highResolutionMSecs() - ts;
+    }
+
+
+    void print() const
+    {
+        double min      = 0.0;
+        double max      = 0.0;
+        double total    = 0.0;
+        uint32_t active = 0;
+        uint32_t slow   = 0;
+
+        for (uint32_t i = 0; i < threads(); ++i) {
+            const auto &stats = m_stats[i];
+
+            LOG_V1("%s" CYAN_BOLD("init #%u") " cpu %" PRId64 " items %u %.0f items/s", Tags::randomx(), i, stats.cpu, stats.items, stats.speed());
+
+            if (!stats.items) {
+                continue;
+            }
+
+            if (!active || stats.speed() < min) {
+                min  = stats.speed();
+                slow = i;
+            }
+
+            max    = std::max(max, stats.speed());
+            total += stats.speed();
+            ++active;
+        }
+
+        if (!active) {
+            return;
+        }
+
+        LOG_INFO("%s" GREEN_BOLD("init ") CYAN_BOLD("%u") " threads items/s min/avg/max " CYAN_BOLD("%.0f/%.0f/%.0f") BLACK_BOLD(" (slowest #%u)"),
+                 Tags::randomx(), threads(), min, total / active, max, slow);
+    }
+
+private:
+    struct Stats
+    {
+        inline double speed() const { return ms > 0.0 ? items * 1000.0 / ms : 0.0; }
+
+        int64_t cpu     = -1;
+        uint32_t items  = 0;
+        double ms       = 0.0;
+    };
+
+
+    void initItems(uint32_t startItem, uint32_t itemCount) const
+    {
+        if (Cpu::info()->hasAVX2() && (itemCount % 5) && itemCount > 5) {
+            randomx_init_dataset(m_dataset, m_cache, startItem, itemCount - (itemCount % 5));
+            randomx_init_dataset(m_dataset, m_cache, startItem + itemCount - 5, 5);
+        }
+        else {
+            randomx_init_dataset(m_dataset, m_cache, startItem, itemCount);
+        }
+    }
+
+
+    randomx_dataset *m_dataset;
+    randomx_cache *m_cache;
+    const int m_priority;
+    const uint32_t m_chunks;
+    const uint32_t m_end;
+    const uint32_t m_start;
+    std::atomic<uint32_t> m_next{};
+    std::vector<Stats> m_stats;
+};
+
+
+class RxInitThreads
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(RxInitThreads)
+
+    explicit RxInitThreads(int64_t node) :
+        m_cpus(cpus(node))
+    {}
+
+
+    ~RxInitThreads()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_shutdown = true;
+        }
+
+        m_cv.notify_all();
+
+        for (auto &thread : m_threads) {
+            thread.join();
+        }
+    }
+
+
+    inline size_t size() const { return m_threads.size(); }
+
+
+    // Only called while the pool is idle, a task uses the first task.threads() workers
+    void grow(uint32_t count)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        for (auto i = static_cast<uint32_t>(m_threads.size()); i < count; ++i) {
+            m_threads.emplace_back(&RxInitThreads::worker, this, i, m_cpus.empty() ? -1 : m_cpus[i % m_cpus.size()], m_generation);
+        }
+    }
+
+
+    void run(RxInitTask &task)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        m_task    = &task;
+        m_pending = std::min<size_t>(task.threads(), size());
+        ++m_generation;
+
+        m_cv.notify_all();
+        m_done.wait(lock, [this] { return m_pending == 0; });
+
+        m_task = nullptr;
+    }
+
+    bool busy = false;
+
+private:
+    // PUs of the node (or the whole machine), first PU of every core before any SMT sibling
+    static std::vector<int64_t> cpus(int64_t node)
+    {
+        std::vector<int64_t> out;
+
+#       ifdef XMRIG_FEATURE_HWLOC
+        auto topology = Cpu::info()->topology();
+        auto cpuset   = hwloc_get_root_obj(topology)->cpuset;
+
+        if (node >= 0) {
+            auto obj = hwloc_get_numanode_obj_by_os_index(topology, static_cast<unsigned>(node));
+            if (obj) {
+                cpuset = obj->cpuset;
+            }
+        }
+
+        const int cores = hwloc_get_nbobjs_inside_cpuset_by_type(topology, cpuset, HWLOC_OBJ_CORE);
+
+        for (unsigned smt = 0; cores > 0; ++smt) {
+            const size_t size = out.size();
+
+            for (int i = 0; i < cores; ++i) {
+                auto core = hwloc_get_obj_inside_cpuset_by_type(topology, cpuset, HWLOC_OBJ_CORE, static_cast<unsigned>(i));
+                auto pu   = core ? hwloc_get_obj_inside_cpuset_by_type(topology, core->cpuset, HWLOC_OBJ_PU, smt) : nullptr;
+
+                if (pu) {
+                    out.emplace_back(pu->os_index);
+                }
+            }
+
+            if (out.size() == size) {
+                break;
+            }
+        }
+#       else
+        for (size_t i = 0; i < Cpu::info()->threads(); ++i) {
+            out.emplace_back(static_cast<int64_t>(i));
+        }
+#       endif
+
+        return out;
+    }
+
+
+    void worker(uint32_t index, int64_t cpu, uint64_t generation)
+    {
+        Platform::trySetThreadAffinity(cpu);
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        while (true) {
+            m_cv.wait(lock, [this, generation] { return m_shutdown || m_generation != generation; });
+
+            if (m_shutdown) {
+                return;
+            }
+
+            generation = m_generation;
+
+            // Threads beyond the task's count may wake up after it is done
+            RxInitTask *task = m_task;
+            if (!task || index >= task->threads()) {
+                continue;
+            }
+
+            lock.unlock();
+            task->run(index, cpu);
+            lock.lock();
+
+            if (--m_pending == 0) {
+                m_done.notify_one();
+            }
+        }
+    }
+
+
+    bool m_shutdown         = false;
+    RxInitTask *m_task      = nullptr;
+    size_t m_pending        = 0;
+    std::condition_variable m_cv;
+    std::condition_variable m_done;
+    std::mutex m_mutex;
+    std::vector<std::thread> m_threads;
+    const std::vector<int64_t> m_cpus;
+    uint64_t m_generation   = 0;
+};
+
+
+static std::map<int64_t, RxInitThreads *> pools;
+static std::mutex mutex;
+
+
+static RxInitThreads *acquire(int64_t node, uint32_t threads)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto &pool = pools[node];
+    if (pool && pool->busy) {
+        return nullptr;
+    }
+
+    // One pool per node sized for the largest request, smaller tasks (precompute) run on a subset of its threads
+    if (!pool) {
+        pool = new RxInitThreads(node);
+    }
+
+    pool->grow(threads);
+
+    pool->busy = true;
+
+    return pool;
+}
+
+
+static void release(RxInitThreads *pool)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    pool->busy = false;
+}
+
+
+} // namespace xmrig
+
+
+void xmrig::RxInitPool::destroy()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (auto &kv : pools) {
+        delete kv.second;
+    }
+
+    pools.clear();
+}
+
+
+void xmrig::RxInitPool::init(randomx_dataset *dataset, randomx_cache *cache, uint32_t startItem, uint32_t itemCount, uint32_t threads, int priority, int64_t node)
+{
+    RxInitTask task(dataset, cache, startItem, itemCount, std::max(threads, 1U), priority);
+
+    if (threads <= 1) {
+        task.run(0, -1);
+    }
+    else if (auto pool = acquire(node, threads)) {
+        pool->run(task);
+        release(pool);
+    }
+    else {
+        // The pinned threads are busy with another dataset (precompute), use temporary threads for this one
+        std::vector<std::thread> workers;
+        workers.reserve(threads);
+
+        for (uint32_t i = 0; i < threads; ++i) {
+            workers.emplace_back(&RxInitTask::run, &task, i, -1);
+        }
+
+        for (auto &thread : workers) {
+            thread.join();
+        }
+    }
+
+    task.print();
+}
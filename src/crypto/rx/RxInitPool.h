@@ -0,0 +1,48 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef XMRIG_RX_INITPOOL_H
+#define XMRIG_RX_INITPOOL_H
+
+
+#include <cstdint>
+
+
+struct randomx_cache;
+struct randomx_dataset;
+
+
+namespace xmrig
+{
+
+
+// Persistent pinned threads for RandomX dataset initialization, items are handed out in small chunks from a shared cursor,
+// so a slow or busy core doesn't hold back the whole dataset.
+class RxInitPool
+{
+public:
+    static void destroy();
+    static void init(randomx_dataset *dataset, randomx_cache *cache, uint32_t startItem, uint32_t itemCount, uint32_t threads, int priority, int64_t node = -1);
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_RX_INITPOOL_H */
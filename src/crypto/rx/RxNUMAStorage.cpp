@@ -166,16 +166,10 @@ public:
     inline void initDatasets(uint32_t threads, int priority)
     {
         uint64_t ts = Chrono::steadyMSecs();
-        uint32_t id = 0;
-
-        for (const auto &kv : m_datasets) {
-            if (kv.second->cache()) {
-                id = kv.first;
-            }
-        }
+        const uint32_t id = sourceNode();
 
         auto primary = dataset(id);
-        primary->init(m_seed.data(), threads, priority);
+        primary->init(m_seed, threads, priority);
 
         printDatasetReady(id, ts);
 
@@ -207,6 +201,19 @@ public:
 
 
 private:
+    // First node in nodeset order whose dataset holds a cache, the same node on every seed change
+    inline uint32_t sourceNode() const
+    {
+        for (uint32_t node : m_nodeset) {
+            if (m_datasets.count(node) && m_datasets.at(node)->cache()) {
+                return node;
+            }
+        }
+
+        return m_datasets.begin()->first;
+    }
+
+
     static void allocate(RxNUMAStoragePrivate *d_ptr, uint32_t nodeId, bool hugePages, bool oneGbPages)
     {
         const uint64_t ts = Chrono::steadyMSecs();
@@ -350,6 +357,14 @@ bool xmrig::RxNUMAStorage::isAllocated() const
 }
 
 
+bool xmrig::RxNUMAStorage::precompute(const RxSeed &, uint32_t, bool, bool, RxConfig::Mode, int)
+{
+    LOG_WARN("%s" YELLOW_BOLD("next dataset precompute is not supported with NUMA datasets"), Tags::randomx());
+
+    return false;
+}
+
+
 xmrig::HugePagesInfo xmrig::RxNUMAStorage::hugePages() const
 {
     if (!d_ptr->isAllocated()) {
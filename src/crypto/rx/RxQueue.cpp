@@ -47,9 +47,14 @@ xmrig::RxQueue::~RxQueue()
     lock.unlock();
 
     m_cv.notify_one();
+    m_precomputeCv.notify_one();
 
     m_thread.join();
 
+    if (m_precomputeThread.joinable()) {
+        m_precomputeThread.join();
+    }
+
     delete m_storage;
 }
 
@@ -74,6 +79,14 @@ xmrig::HugePagesInfo xmrig::RxQueue::hugePages()
 }
 
 
+bool xmrig::RxQueue::isPending()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_state == STATE_PENDING;
+}
+
+
 template<typename T>
 bool xmrig::RxQueue::isReady(const T &seed)
 {
@@ -113,6 +126,29 @@ void xmrig::RxQueue::enqueue(const RxSeed &seed, const std::vector<uint32_t> &no
 }
 
 
+void xmrig::RxQueue::precompute(const RxSeed &seed, const std::vector<uint32_t> &nodeset, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    // The next seed is only known once the current dataset is ready, it must use the same algorithm
+    if (m_precomputeDisabled || !isReadyUnsafe(m_seed) || m_seed == seed || m_nextSeed == seed || m_seed.algorithm() != seed.algorithm()) {
+        return;
+    }
+
+    m_precompute.clear();
+    m_precompute.emplace_back(seed, nodeset, threads, hugePages, oneGbPages, mode, priority);
+    m_nextSeed = seed;
+
+    if (!m_precomputeThread.joinable()) {
+        m_precomputeThread = std::thread(&RxQueue::backgroundPrecompute, this);
+    }
+
+    lock.unlock();
+
+    m_precomputeCv.notify_one();
+}
+
+
 template<typename T>
 bool xmrig::RxQueue::isReadyUnsafe(const T &seed) const
 {
@@ -162,6 +198,43 @@ void xmrig::RxQueue::backgroundInit()
 }
 
 
+void xmrig::RxQueue::backgroundPrecompute()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (m_state != STATE_SHUTDOWN) {
+        if (m_precompute.empty()) {
+            m_precomputeCv.wait(lock, [this]{ return m_state == STATE_SHUTDOWN || !m_precompute.empty(); });
+
+            continue;
+        }
+
+        const auto item = m_precompute.back();
+        m_precompute.clear();
+
+        lock.unlock();
+
+        LOG_INFO("%s" MAGENTA_BOLD("precompute next dataset") " algo " WHITE_BOLD("%s (") CYAN_BOLD("%u") WHITE_BOLD(" threads)") BLACK_BOLD(" seed %s..."),
+                 Tags::randomx(),
+                 item.seed.algorithm().name(),
+                 item.threads,
+                 Cvt::toHex(item.seed.data().data(), 8).data()
+                 );
+
+        const bool enabled = m_storage->precompute(item.seed, item.threads, item.hugePages, item.oneGbPages, item.mode, item.priority);
+
+        lock.lock();
+
+        if (!enabled) {
+            m_precomputeDisabled = true;
+            m_precompute.clear();
+
+            LOG_WARN("%s" YELLOW_BOLD("next dataset precompute disabled"), Tags::randomx());
+        }
+    }
+}
+
+
 void xmrig::RxQueue::onReady()
 {
     std::unique_lock<std::mutex> lock(m_mutex);
@@ -76,8 +76,10 @@ public:
 
     HugePagesInfo hugePages();
     RxDataset *dataset(const Job &job, uint32_t nodeId);
+    bool isPending();
     template<typename T> bool isReady(const T &seed);
     void enqueue(const RxSeed &seed, const std::vector<uint32_t> &nodeset, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority);
+    void precompute(const RxSeed &seed, const std::vector<uint32_t> &nodeset, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority);
 
 protected:
     inline void onAsync() override  { onReady(); }
@@ -91,16 +93,22 @@ private:
 
     template<typename T> bool isReadyUnsafe(const T &seed) const;
     void backgroundInit();
+    void backgroundPrecompute();
     void onReady();
 
-    IRxListener *m_listener = nullptr;
-    IRxStorage *m_storage   = nullptr;
+    bool m_precomputeDisabled   = false;
+    IRxListener *m_listener     = nullptr;
+    IRxStorage *m_storage       = nullptr;
+    RxSeed m_nextSeed;
     RxSeed m_seed;
     State m_state = STATE_IDLE;
     std::condition_variable m_cv;
+    std::condition_variable m_precomputeCv;
     std::mutex m_mutex;
     std::shared_ptr<Async> m_async;
+    std::thread m_precomputeThread;
     std::thread m_thread;
+    std::vector<RxQueueItem> m_precompute;
     std::vector<RxQueueItem> m_queue;
 };
 
@@ -18,13 +18,40 @@
  */
 
 
+#include <mutex>
+#include <vector>
+
+
 #include "crypto/randomx/randomx.h"
 #include "backend/cpu/Cpu.h"
+#include "crypto/common/VirtualMemory.h"
 #include "crypto/rx/RxCache.h"
 #include "crypto/rx/RxDataset.h"
 #include "crypto/rx/RxVm.h"
 
 
+namespace xmrig {
+
+
+struct RxPooledVm
+{
+    randomx_vm *vm              = nullptr;
+    VirtualMemory *memory       = nullptr;
+    randomx_cache *cache        = nullptr;
+    randomx_dataset *dataset    = nullptr;
+    Buffer seed;
+    bool softAes                = false;
+    bool busy                   = false;
+};
+
+
+static std::mutex vmPoolMutex;
+static std::vector<RxPooledVm> vmPool;
+
+
+} // namespace xmrig
+
+
 randomx_vm *xmrig::RxVm::create(RxDataset *dataset, uint8_t *scratchpad, bool softAes, const Assembly &assembly, uint32_t node)
 {
     int flags = 0;
@@ -56,3 +83,86 @@ void xmrig::RxVm::destroy(randomx_vm* vm)
         randomx_destroy_vm(vm);
     }
 }
+
+
+randomx_vm *xmrig::RxVm::acquire(RxDataset *dataset, bool softAes)
+{
+    std::lock_guard<std::mutex> lock(vmPoolMutex);
+
+    randomx_dataset *full = dataset->get();
+    randomx_cache *cache  = dataset->cache() ? dataset->cache()->get() : nullptr;
+
+    for (auto &entry : vmPool) {
+        if (entry.busy || entry.softAes != softAes || (entry.dataset == nullptr) != (full == nullptr)) {
+            continue;
+        }
+
+        if (full) {
+            if (entry.dataset != full) {
+                randomx_vm_set_dataset(entry.vm, full);
+                entry.dataset = full;
+            }
+        }
+        else if (entry.cache != cache || entry.seed != dataset->cache()->seed()) {
+            // Light VMs compile the superscalar hash from the cache, so it must be redone after a seed change.
+            randomx_vm_set_cache(entry.vm, cache);
+            entry.cache = cache;
+            entry.seed  = dataset->cache()->seed();
+        }
+
+        entry.busy = true;
+
+        return entry.vm;
+    }
+
+    RxPooledVm entry;
+    entry.memory  = new VirtualMemory(RANDOMX_SCRATCHPAD_L3_MAX_SIZE, false, false, false);
+    entry.vm      = create(dataset, entry.memory->scratchpad(), softAes, Assembly::NONE, 0);
+    entry.softAes = softAes;
+    entry.busy    = true;
+
+    if (!entry.vm) {
+        delete entry.memory;
+
+        return nullptr;
+    }
+
+    if (full) {
+        entry.dataset = full;
+    }
+    else {
+        entry.cache = cache;
+        entry.seed  = dataset->cache()->seed();
+    }
+
+    vmPool.emplace_back(std::move(entry));
+
+    return vmPool.back().vm;
+}
+
+
+void xmrig::RxVm::release(randomx_vm *vm)
+{
+    std::lock_guard<std::mutex> lock(vmPoolMutex);
+
+    for (auto &entry : vmPool) {
+        if (entry.vm == vm) {
+            entry.busy = false;
+
+            return;
+        }
+    }
+}
+
+
+void xmrig::RxVm::releaseAll()
+{
+    std::lock_guard<std::mutex> lock(vmPoolMutex);
+
+    for (auto &entry : vmPool) {
+        destroy(entry.vm);
+        delete entry.memory;
+    }
+
+    vmPool.clear();
+}
@@ -40,6 +40,11 @@ class RxVm
 public:
     static randomx_vm *create(RxDataset *dataset, uint8_t *scratchpad, bool softAes, const Assembly &assembly, uint32_t node);
     static void destroy(randomx_vm *vm);
+
+    // Reusable VMs for share verification, bound to the current cache/dataset of the given RxDataset.
+    static randomx_vm *acquire(RxDataset *dataset, bool softAes);
+    static void release(randomx_vm *vm);
+    static void releaseAll();
 };
 
 
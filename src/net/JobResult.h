@@ -31,6 +31,7 @@
 #include <cstdint>
 
 
+#include "3rdparty/rapidjson/document.h"
 #include "base/tools/String.h"
 #include "base/net/stratum/Job.h"
 
@@ -38,6 +39,50 @@
 namespace xmrig {
 
 
+// Inline copy of a job or client id, creating, queuing and copying results doesn't touch the heap.
+// Ids longer than kMaxSize (no known pool sends them) fall back to a String copy.
+class JobResultId
+{
+public:
+    constexpr static size_t kMaxSize = 79;
+
+    inline JobResultId(const String &id) :
+        m_long(id.size() > kMaxSize ? id : String()),
+        m_null(id.isNull())
+    {
+        if (!m_null && m_long.isNull()) {
+            m_size = id.size();
+            memcpy(m_data, id.data(), m_size + 1);
+        }
+    }
+
+    inline bool isNull() const                          { return m_null; }
+    inline bool operator!=(const String &other) const   { return !(*this == other); }
+    inline const char *data() const                     { return m_null ? nullptr : (m_long.isNull() ? m_data : m_long.data()); }
+    inline size_t size() const                          { return m_long.isNull() ? m_size : m_long.size(); }
+
+    inline bool operator==(const String &other) const
+    {
+        if (m_null || other.isNull()) {
+            return m_null == other.isNull();
+        }
+
+        return size() == other.size() && memcmp(data(), other.data(), size()) == 0;
+    }
+
+    inline rapidjson::Value toJSON() const
+    {
+        return m_null ? rapidjson::Value(rapidjson::kNullType) : rapidjson::Value(rapidjson::StringRef(data(), size()));
+    }
+
+private:
+    char m_data[kMaxSize + 1]{};
+    String m_long;
+    bool m_null;
+    size_t m_size = 0;
+};
+
+
 class JobResult
 {
 public:
@@ -89,8 +134,8 @@ public:
 
     const Algorithm algorithm;
     const uint8_t index;
-    const String clientId;
-    const String jobId;
+    const JobResultId clientId;
+    const JobResultId jobId;
     const uint32_t backend;
     const uint64_t nonce;
     const uint64_t diff;
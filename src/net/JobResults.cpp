@@ -36,6 +36,7 @@
 #ifdef XMRIG_ALGO_RANDOMX
 #   include "crypto/randomx/randomx.h"
 #   include "crypto/rx/Rx.h"
+#   include "crypto/rx/RxDataset.h"
 #   include "crypto/rx/RxVm.h"
 #endif
 
@@ -47,6 +48,7 @@
 
 
 #if defined(XMRIG_FEATURE_OPENCL) || defined(XMRIG_FEATURE_CUDA)
+#   include "backend/common/Profile.h"
 #   include "base/tools/Baton.h"
 #   include "crypto/cn/CnCtx.h"
 #   include "crypto/cn/CnHash.h"
@@ -55,6 +57,7 @@
 #endif
 
 
+#include <atomic>
 #include <cassert>
 #include <list>
 #include <memory>
@@ -114,8 +117,10 @@ static inline void checkHash(const JobBundle &bundle, std::vector<JobResult> &re
 
 static void getResults(JobBundle &bundle, std::vector<JobResult> &results, uint32_t &errors, bool hwAES)
 {
+    ProfileSample sample(Profile::VERIFY);
+
     const auto &algorithm = bundle.job.algorithm();
-    auto memory           = new VirtualMemory(algorithm.l3(), false, false, false);
+    auto memory           = algorithm.family() == Algorithm::RANDOM_X ? nullptr : new VirtualMemory(algorithm.l3(), false, false, false);
     alignas(16) uint8_t hash[32]{ 0 };
 
     if (algorithm.family() == Algorithm::RANDOM_X) {
@@ -123,12 +128,20 @@ static void getResults(JobBundle &bundle, std::vector<JobResult> &results, uint3
         RxDataset *dataset = Rx::dataset(bundle.job, 0);
         if (dataset == nullptr) {
             errors += bundle.nonces.size();
-            delete memory;
 
             return;
         }
 
-        auto vm = RxVm::create(dataset, memory->scratchpad(), !hwAES, Assembly::NONE, 0);
+        // Pooled VMs keep their scratchpad and compiled code between bundles, creating a VM per bundle
+        // would also cycle through the shared randomx VM arena.
+        auto vm = RxVm::acquire(dataset, !hwAES);
+        if (vm == nullptr) {
+            errors += bundle.nonces.size();
+
+            return;
+        }
+
+        dataset->addUser();
 
         for (uint32_t nonce : bundle.nonces) {
             *bundle.job.nonce() = nonce;
@@ -138,7 +151,8 @@ static void getResults(JobBundle &bundle, std::vector<JobResult> &results, uint3
             checkHash(bundle, results, nonce, hash, errors);
         }
 
-        RxVm::destroy(vm);
+        dataset->removeUser();
+        RxVm::release(vm);
 #       endif
     }
     else if (algorithm.family() == Algorithm::ARGON2) {
@@ -158,6 +172,7 @@ static void getResults(JobBundle &bundle, std::vector<JobResult> &results, uint3
             uint32_t mix_hash[8];
             {
                 std::lock_guard<std::mutex> lock(KPCache::s_cacheMutex);
+                ProfileSample kawpow(Profile::KAWPOW);
 
                 KPCache::s_cache.init(bundle.job.height() / KPHash::EPOCH_LENGTH);
                 KPHash::calculate(KPCache::s_cache, bundle.job.height(), header_hash, full_nonce, output, mix_hash);
@@ -195,6 +210,88 @@ static void getResults(JobBundle &bundle, std::vector<JobResult> &results, uint3
 #endif
 
 
+// Single-producer/single-consumer ring of results, each producer thread leases its own ring,
+// the libuv thread drains all rings in onAsync().
+class JobResultsRing
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE(JobResultsRing)
+
+    constexpr static size_t kSize = 256;
+
+    inline JobResultsRing() = default;
+    inline ~JobResultsRing()                { drain([](const JobResult &) {}); }
+
+    inline bool acquire()                   { bool owned = false; return m_owned.compare_exchange_strong(owned, true, std::memory_order_acquire); }
+    inline void release()                   { m_owned.store(false, std::memory_order_release); }
+
+
+    inline bool push(const JobResult &result)
+    {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail.load(std::memory_order_acquire) >= kSize) {
+            return false;
+        }
+
+        new (slot(head)) JobResult(result);
+        m_head.store(head + 1, std::memory_order_release);
+
+        return true;
+    }
+
+
+    template<typename T>
+    inline void drain(T callback)
+    {
+        size_t tail       = m_tail.load(std::memory_order_relaxed);
+        const size_t head = m_head.load(std::memory_order_acquire);
+
+        for (; tail != head; ++tail) {
+            JobResult *result = slot(tail);
+            callback(*result);
+            result->~JobResult();
+        }
+
+        m_tail.store(tail, std::memory_order_release);
+    }
+
+
+    JobResultsRing *next = nullptr;
+
+private:
+    inline JobResult *slot(size_t index)    { return reinterpret_cast<JobResult *>(m_slots + (index & (kSize - 1)) * sizeof(JobResult)); }
+
+    // Producer and consumer indices are kept on separate cache lines
+    std::atomic<size_t> m_head{ 0 };
+    char m_headPad[64 - sizeof(std::atomic<size_t>)]{};
+    std::atomic<size_t> m_tail{ 0 };
+    char m_tailPad[64 - sizeof(std::atomic<size_t>)]{};
+    std::atomic<bool> m_owned{ false };
+    alignas(alignof(JobResult)) uint8_t m_slots[kSize * sizeof(JobResult)]{};
+};
+
+
+static std::atomic<uint64_t> generation{ 0 };
+
+
+class JobResultsLease
+{
+public:
+    inline ~JobResultsLease()
+    {
+        if (ring && id == generation.load(std::memory_order_acquire)) {
+            ring->release();
+        }
+    }
+
+    JobResultsRing *ring = nullptr;
+    uint64_t id          = 0;
+};
+
+
+static thread_local JobResultsLease lease;
+
+
 class JobResultsPrivate : public IAsyncListener
 {
 public:
@@ -208,13 +305,28 @@ public:
     }
 
 
-    ~JobResultsPrivate() override = default;
+    ~JobResultsPrivate() override
+    {
+        JobResultsRing *ring = m_rings.load(std::memory_order_acquire);
+        while (ring) {
+            JobResultsRing *next = ring->next;
+            delete ring;
+            ring = next;
+        }
+    }
+
+
+    inline uint64_t overflows() const   { return m_overflows.load(std::memory_order_relaxed); }
 
 
     inline void submit(const JobResult &result)
     {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        m_results.push_back(result);
+        if (!this->ring()->push(result)) {
+            m_overflows.fetch_add(1, std::memory_order_relaxed);
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_results.push_back(result);
+        }
 
         m_async->send();
     }
@@ -236,9 +348,46 @@ protected:
 
 
 private:
+    JobResultsRing *ring()
+    {
+        const uint64_t id = generation.load(std::memory_order_acquire);
+        if (lease.ring && lease.id == id) {
+            return lease.ring;
+        }
+
+        JobResultsRing *ring = m_rings.load(std::memory_order_acquire);
+        while (ring && !ring->acquire()) {
+            ring = ring->next;
+        }
+
+        if (!ring) {
+            ring = new JobResultsRing();
+            ring->acquire();
+            ring->next = m_rings.load(std::memory_order_relaxed);
+
+            while (!m_rings.compare_exchange_weak(ring->next, ring, std::memory_order_release, std::memory_order_relaxed)) {}
+        }
+
+        lease.ring = ring;
+        lease.id   = id;
+
+        return ring;
+    }
+
+
+    inline void drain()
+    {
+        for (JobResultsRing *ring = m_rings.load(std::memory_order_acquire); ring != nullptr; ring = ring->next) {
+            ring->drain([this](const JobResult &result) { m_listener->onJobResult(result); });
+        }
+    }
+
+
 #   if defined(XMRIG_FEATURE_OPENCL) || defined(XMRIG_FEATURE_CUDA)
     inline void submit()
     {
+        drain();
+
         std::list<JobBundle> bundles;
         std::list<JobResult> results;
 
@@ -279,6 +428,8 @@ private:
 #   else
     inline void submit()
     {
+        drain();
+
         std::list<JobResult> results;
 
         m_mutex.lock();
@@ -293,6 +444,8 @@ private:
 
     const bool m_hwAES;
     IJobResultListener *m_listener;
+    std::atomic<JobResultsRing *> m_rings{ nullptr };
+    std::atomic<uint64_t> m_overflows{ 0 };
     std::list<JobResult> m_results;
     std::mutex m_mutex;
     std::shared_ptr<Async> m_async;
@@ -315,10 +468,17 @@ void xmrig::JobResults::done(const Job &job)
 }
 
 
+uint64_t xmrig::JobResults::overflows()
+{
+    return handler ? handler->overflows() : 0;
+}
+
+
 void xmrig::JobResults::setListener(IJobResultListener *listener, bool hwAES)
 {
     assert(handler == nullptr);
 
+    generation.fetch_add(1, std::memory_order_acq_rel);
     handler = new JobResultsPrivate(listener, hwAES);
 }
 
@@ -327,6 +487,7 @@ void xmrig::JobResults::stop()
 {
     assert(handler != nullptr);
 
+    generation.fetch_add(1, std::memory_order_acq_rel);
     delete handler;
 
     handler = nullptr;
@@ -42,6 +42,7 @@ class JobResult;
 class JobResults
 {
 public:
+    static uint64_t overflows();
     static void done(const Job &job);
     static void setListener(IJobResultListener *listener, bool hwAES);
     static void stop();
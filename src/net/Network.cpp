@@ -27,8 +27,10 @@
 #include "base/io/log/Log.h"
 #include "base/io/log/Tags.h"
 #include "base/net/stratum/Client.h"
+#include "base/net/stratum/JobLatency.h"
 #include "base/net/stratum/NetworkState.h"
 #include "base/net/stratum/SubmitResult.h"
+#include "base/net/tools/LineReader.h"
 #include "base/tools/Chrono.h"
 #include "base/tools/Timer.h"
 #include "core/config/Config.h"
@@ -169,6 +171,9 @@ void xmrig::Network::onJob(IStrategy *strategy, IClient *client, const Job &job,
         return;
     }
 
+    // Only jobs that reach the workers are measured, not those of standby pools or an inactive donate pool.
+    JobLatency::received();
+
     setJob(client, job, m_donate == strategy);
 }
 
@@ -258,6 +263,11 @@ void xmrig::Network::onRequest(IApiRequest &request)
         getResults(request.reply(), request.doc(), request.version());
         getConnection(request.reply(), request.doc(), request.version());
     }
+    else if (request.type() == IApiRequest::REQ_METRICS) {
+        request.accept();
+
+        m_state->getMetrics(request.metrics());
+    }
 }
 #endif
 
@@ -323,6 +333,13 @@ void xmrig::Network::getConnection(rapidjson::Value &reply, rapidjson::Document
 
     reply.AddMember("algo",         m_state->algorithm().toJSON(), allocator);
     reply.AddMember("connection",   m_state->getConnection(doc, version), allocator);
+
+    // Line reader counters are shared by all pool connections since start, not only the current one.
+    Value bytes(kObjectType);
+    bytes.AddMember("parsed",       LineReader::totalParsed(), allocator);
+    bytes.AddMember("copied",       LineReader::totalCopied(), allocator);
+
+    reply.AddMember("stratum_bytes", bytes, allocator);
 }
 
 
@@ -331,6 +348,9 @@ void xmrig::Network::getResults(rapidjson::Value &reply, rapidjson::Document &do
     using namespace rapidjson;
     auto &allocator = doc.GetAllocator();
 
-    reply.AddMember("results", m_state->getResults(doc, version), allocator);
+    Value results = m_state->getResults(doc, version);
+    results.AddMember("ring_overflows", JobResults::overflows(), allocator);
+
+    reply.AddMember("results", results, allocator);
 }
 #endif